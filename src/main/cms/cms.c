@@ -80,6 +80,9 @@
 // Should be as big as the maximum number of rows displayed
 // simultaneously in the tallest supported screen.
 static uint8_t entry_flags[32];
+// Hash of the last value written to each row, 0 if none. Used to skip
+// rewriting polled values which haven't changed since the last poll.
+static uint32_t entry_value_hash[32];
 
 #define IS_PRINTVALUE(p, row) (entry_flags[row] & PRINT_VALUE)
 #define SET_PRINTVALUE(p, row) { entry_flags[row] |= PRINT_VALUE; }
@@ -331,14 +334,32 @@ static void cmsPadToSize(char *buf, int size)
     cmsPadLeftToSize(buf, size);
 }
 
-static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row, uint8_t maxSize)
+static int cmsWriteMenuValue(displayPort_t *pDisplay, uint8_t col, uint8_t row, uint8_t screenRow, const char *text)
+{
+    // FNV-1a over the column and the text, so moving a value
+    // also rewrites it.
+    uint32_t hash = (2166136261U ^ col) * 16777619U;
+    for (const char *c = text; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619U;
+    }
+    if (hash == 0) {
+        hash = 1;
+    }
+    if (entry_value_hash[screenRow] == hash) {
+        return 0;
+    }
+    entry_value_hash[screenRow] = hash;
+    return displayWrite(pDisplay, col, row, text);
+}
+
+static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row, uint8_t screenRow, uint8_t maxSize)
 {
     int colpos;
     int cnt;
 
     cmsPadToSize(buff, maxSize);
     colpos = rightMenuColumn - maxSize;
-    cnt = displayWrite(pDisplay, colpos, row, buff);
+    cnt = cmsWriteMenuValue(pDisplay, colpos, row, screenRow, buff);
     return cnt;
 }
 
@@ -359,7 +380,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
     case OME_String:
         if (IS_PRINTVALUE(p, screenRow) && p->data) {
             strncpy(buff, p->data, CMS_DRAW_BUFFER_LEN);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_DRAW_BUFFER_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_DRAW_BUFFER_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -377,7 +398,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
             strncat(buff, ">", CMS_DRAW_BUFFER_LEN);
 
             row = smallScreen ? row - 1 : row;
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, strlen(buff));
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, strlen(buff));
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -390,7 +411,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 strcpy(buff, "NO");
             }
 
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, 3);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -404,7 +425,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 strcpy(buff, "NO");
             }
 
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, 3);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -414,7 +435,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
             const OSD_TAB_t *ptr = p->data;
             char * str = (char *)ptr->names[*ptr->val];
             strncpy(buff, str, CMS_DRAW_BUFFER_LEN);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_DRAW_BUFFER_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_DRAW_BUFFER_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -429,7 +450,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 val = ptr->val;
             }
             itoa(*val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_NUM_FIELD_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -444,7 +465,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 val = ptr->val;
             }
             itoa(*val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_NUM_FIELD_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -459,7 +480,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 val = ptr->val;
             }
             itoa(*val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_NUM_FIELD_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -474,7 +495,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 val = ptr->val;
             }
             itoa(*val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_NUM_FIELD_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -483,7 +504,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(p, screenRow) && p->data) {
             const OSD_FLOAT_t *ptr = p->data;
             cmsFormatFloat(*ptr->val * ptr->multipler, buff);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, CMS_NUM_FIELD_LEN);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -551,7 +572,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                     strcat(buff, suffix);
                 }
             }
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, maxSize);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, screenRow, maxSize);
             CLR_PRINTVALUE(p, screenRow);
         }
         break;
@@ -571,8 +592,8 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 }
             }
             if (text) {
-                cnt = displayWrite(pDisplay,
-                        leftMenuColumn + 1 + (uint8_t) strlen(p->text), row, text);
+                cnt = cmsWriteMenuValue(pDisplay,
+                        leftMenuColumn + 1 + (uint8_t) strlen(p->text), row, screenRow, text);
             }
             CLR_PRINTVALUE(p, screenRow);
         }
@@ -621,6 +642,7 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
     if (pDisplay->cleared) {
         // Mark all labels and values for printing
         memset(entry_flags, PRINT_LABEL | PRINT_VALUE, sizeof(entry_flags));
+        memset(entry_value_hash, 0, sizeof(entry_value_hash));
         pDisplay->cleared = false;
     } else if (drawPolled) {
         for (p = pageTop, i = 0; p <= pageTop + pageMaxRow; p++, i++) {
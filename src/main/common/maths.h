@@ -31,7 +31,9 @@
 // Use floating point M_PI instead explicitly.
 #define M_PIf   3.14159265358979323846f
 #define M_LN2f  0.69314718055994530942f
+#ifndef M_Ef    // Newer libc math.h has it with a different literal
 #define M_Ef    2.71828182845904523536f
+#endif
 
 #define RAD (M_PIf / 180.0f)
 
@@ -151,10 +151,11 @@ static inline fpQuaternion_t * quaternionNormalize(fpQuaternion_t * result, cons
         result->q3 = 0;
     }
     else {
-        result->q0 = q->q0 / mod;
-        result->q1 = q->q1 / mod;
-        result->q2 = q->q2 / mod;
-        result->q3 = q->q3 / mod;
+        const float invMod = 1.0f / mod;
+        result->q0 = q->q0 * invMod;
+        result->q1 = q->q1 * invMod;
+        result->q2 = q->q2 * invMod;
+        result->q3 = q->q3 * invMod;
     }
 
     return result;
@@ -76,9 +76,10 @@ static inline fpVector3_t * vectorNormalize(fpVector3_t * result, const fpVector
 {
     float length = fast_fsqrtf(vectorNormSquared(v));
     if (length != 0) {
-        result->x = v->x / length;
-        result->y = v->y / length;
-        result->z = v->z / length;
+        const float invLength = 1.0f / length;
+        result->x = v->x * invLength;
+        result->y = v->y * invLength;
+        result->z = v->z * invLength;
     }
     else {
         result->x = 0;
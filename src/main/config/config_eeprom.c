@@ -30,9 +30,11 @@
 #include "config/config_eeprom.h"
 #include "config/config_streamer.h"
 #include "config/parameter_group.h"
+#include "config/parameter_group_ids.h"
 
 #include "drivers/system.h"
 #include "drivers/flash.h"
+#include "drivers/time.h"
 
 #include "fc/config.h"
 
@@ -40,7 +42,13 @@
     void config_streamer_impl_unlock(void);
 #endif
 
-static uint16_t eepromConfigSize;
+static uint32_t eepromConfigSize;
+static bool eepromContentValid;             // Cached result of the last scan, cleared on every write
+static timeDelta_t eepromValidateTimeUs;
+static timeDelta_t eepromLoadTimeUs;
+static uint16_t eepromGeneration;
+static const uint8_t *eepromJournalStart;  // first delta block, NULL when the stored copy can't take deltas
+static const uint8_t *eepromJournalEnd;    // where the next delta block goes
 
 typedef enum {
     CR_CLASSICATION_SYSTEM   = 0,
@@ -76,6 +84,19 @@ typedef struct {
 } PG_PACKED configFooter_t;
 // checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
 
+// Header for each delta block appended after the saved copy. A delta block carries the records
+// changed since the previous save, followed by a footer and checksum just like the saved copy.
+// Records in later blocks override earlier ones. The region is rewritten from scratch only when
+// the next block doesn't fit anymore.
+typedef struct {
+    uint16_t size;          // Whole block including checksum and flash write padding
+    uint16_t generation;    // Must match the generation record of the saved copy
+} PG_PACKED configJournalHeader_t;
+
+// The saved copy carries its generation in a record using an unused PGN, so stale delta blocks
+// left behind a rewritten copy are never replayed. Older firmware just skips the record.
+#define CONFIG_GENERATION_PGN   PG_ID_INVALID
+
 // Used to check the compiler packing at build time.
 typedef struct {
     uint8_t byte;
@@ -117,6 +138,7 @@ void initEEPROM(void)
     BUILD_BUG_ON(sizeof(configHeader_t) != 1);
     BUILD_BUG_ON(sizeof(configFooter_t) != 2);
     BUILD_BUG_ON(sizeof(configRecord_t) != 6);
+    BUILD_BUG_ON(sizeof(configJournalHeader_t) != 4);
 
 #if defined(CONFIG_IN_EXTERNAL_FLASH)
     bool eepromLoaded = loadEEPROMFromExternalFlash();
@@ -129,21 +151,23 @@ void initEEPROM(void)
 #endif
 }
 
-// Scan the EEPROM config. Returns true if the config is valid.
-bool isEEPROMContentValid(void)
+static const uint8_t *alignToWriteSize(const uint8_t *p)
 {
-    const uint8_t *p = &__config_start;
-    const configHeader_t *header = (const configHeader_t *)p;
-
-    if (header->format != EEPROM_CONF_VERSION) {
-        return false;
-    }
-    uint16_t crc = crc16_ccitt_update(0, header, sizeof(*header));
-    p += sizeof(*header);
+    const uint32_t offset = p - &__config_start;
+    return &__config_start + ((offset + CONFIG_STREAMER_BUFFER_SIZE - 1) / CONFIG_STREAMER_BUFFER_SIZE) * CONFIG_STREAMER_BUFFER_SIZE;
+}
 
+// Scan records up to the footer and verify the checksum following it.
+// Returns the address just past the checksum, NULL if the records are not valid.
+static const uint8_t *scanEEPROMRecords(const uint8_t *p, uint16_t crc)
+{
     for (;;) {
         const configRecord_t *record = (const configRecord_t *)p;
 
+        if (p + sizeof(configFooter_t) + sizeof(uint16_t) > &__config_end) {
+            return NULL;
+        }
+
         if (record->size == 0) {
             // Found the end.  Stop scanning.
             break;
@@ -151,12 +175,12 @@ bool isEEPROMContentValid(void)
 
         if (p + sizeof(*record) >= &__config_end) {
             // Too big. Further checking for size doesn't make sense
-            return false;
+            return NULL;
         }
 
         if (p + record->size >= &__config_end || record->size < sizeof(*record)) {
             // Too big or too small.
-            return false;
+            return NULL;
         }
 
         crc = crc16_ccitt_update(crc, p, record->size);
@@ -169,22 +193,15 @@ bool isEEPROMContentValid(void)
     p += sizeof(*footer);
     const uint16_t checkSum = *(uint16_t *)p;
     p += sizeof(checkSum);
-    eepromConfigSize = p - &__config_start;
-    return crc == checkSum;
-}
 
-uint16_t getEEPROMConfigSize(void)
-{
-    return eepromConfigSize;
+    return crc == checkSum ? p : NULL;
 }
 
-// find config record for reg + classification (profile info) in EEPROM
+// find config record for pgn + classification (profile info) in a sequence of records
 // return NULL when record is not found
-// this function assumes that EEPROM content is valid
-static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+// this function assumes that the records are valid
+static const configRecord_t *findEEPROMRecord(const uint8_t *p, pgn_t pgn, configRecordFlags_e classification)
 {
-    const uint8_t *p = &__config_start;
-    p += sizeof(configHeader_t);             // skip header
     while (true) {
         const configRecord_t *record = (const configRecord_t *)p;
         // Ensure that the record header fits into config memory, otherwise accessing size and flags may cause a hardfault.
@@ -198,7 +215,7 @@ static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFla
         }
 
         // Check if this is the record we're looking for (check for size)
-        if (pgN(reg) == record->pgn && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
+        if (pgn == record->pgn && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
             return record;
         }
 
@@ -208,11 +225,135 @@ static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFla
     return NULL;
 }
 
+// Scan the EEPROM config. Returns true if the config is valid.
+// Delta blocks are validated one by one, the first torn or stale block ends the journal.
+static bool scanEEPROM(void)
+{
+    const uint8_t *p = &__config_start;
+    const configHeader_t *header = (const configHeader_t *)p;
+
+    eepromJournalStart = NULL;
+    eepromJournalEnd = NULL;
+
+    if (header->format != EEPROM_CONF_VERSION) {
+        return false;
+    }
+    uint16_t crc = crc16_ccitt_update(0, header, sizeof(*header));
+    p = scanEEPROMRecords(p + sizeof(*header), crc);
+    if (!p) {
+        return false;
+    }
+    eepromConfigSize = p - &__config_start;
+
+    const configRecord_t *generation = findEEPROMRecord(&__config_start + sizeof(*header), CONFIG_GENERATION_PGN, CR_CLASSICATION_SYSTEM);
+    if (!generation || generation->size != sizeof(configRecord_t) + sizeof(eepromGeneration)) {
+        // Written by firmware without delta support, the next save rewrites it
+        eepromGeneration = 0;
+        return true;
+    }
+    memcpy(&eepromGeneration, generation->pg, sizeof(eepromGeneration));
+
+    p = alignToWriteSize(p);
+    eepromJournalStart = p;
+
+    while (p + sizeof(configJournalHeader_t) <= &__config_end) {
+        const configJournalHeader_t *journal = (const configJournalHeader_t *)p;
+
+        if (journal->generation != eepromGeneration || journal->size < sizeof(*journal) || p + journal->size > &__config_end) {
+            break;
+        }
+
+        const uint8_t *blockEnd = scanEEPROMRecords(p + sizeof(*journal), crc16_ccitt_update(0, journal, sizeof(*journal)));
+        if (!blockEnd || alignToWriteSize(blockEnd) != p + journal->size) {
+            break;
+        }
+
+        p += journal->size;
+        eepromConfigSize = blockEnd - &__config_start;
+    }
+
+    eepromJournalEnd = p;
+    return true;
+}
+
+bool isEEPROMContentValid(void)
+{
+    const timeUs_t startTimeUs = micros();
+    eepromContentValid = scanEEPROM();
+    eepromValidateTimeUs = micros() - startTimeUs;
+
+    return eepromContentValid;
+}
+
+uint32_t getEEPROMConfigSize(void)
+{
+    return eepromConfigSize;
+}
+
+timeDelta_t getEEPROMValidateTimeUs(void)
+{
+    return eepromValidateTimeUs;
+}
+
+timeDelta_t getEEPROMLoadTimeUs(void)
+{
+    return eepromLoadTimeUs;
+}
+
+// find the most recent config record for reg + classification (profile info) in EEPROM
+// return NULL when record is not found
+// this function assumes that EEPROM content is valid
+static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const configRecord_t *record = findEEPROMRecord(&__config_start + sizeof(configHeader_t), pgN(reg), classification);
+
+    if (eepromJournalStart) {
+        for (const uint8_t *p = eepromJournalStart; p < eepromJournalEnd; p += ((const configJournalHeader_t *)p)->size) {
+            const configRecord_t *delta = findEEPROMRecord(p + sizeof(configJournalHeader_t), pgN(reg), classification);
+            if (delta) {
+                record = delta;
+            }
+        }
+    }
+
+    return record;
+}
+
+// Return the record for reg + classification (profile info) from the saved copy.
+// The saved copy is written in registry order, so the record is normally the one at the cursor.
+// Only records written by a firmware with a different set of PGs need a search from the start.
+static const configRecord_t *nextEEPROMRecord(const uint8_t **cursor, const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const configRecord_t *record = (const configRecord_t *)*cursor;
+
+    if (*cursor + sizeof(*record) < &__config_end && record->size != 0 && record->pgn == CONFIG_GENERATION_PGN) {
+        *cursor += record->size;
+        record = (const configRecord_t *)*cursor;
+    }
+
+    if (*cursor + sizeof(*record) < &__config_end && record->size >= sizeof(*record) && *cursor + record->size < &__config_end &&
+            record->pgn == pgN(reg) && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
+        *cursor += record->size;
+        return record;
+    }
+
+    return findEEPROMRecord(&__config_start + sizeof(configHeader_t), pgN(reg), classification);
+}
+
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// PGs are processed in registry order in a single pass over the saved copy, then the records
+// of the delta blocks are applied on top, in the order they were saved.
 bool loadEEPROM(void)
 {
+    const timeUs_t startTimeUs = micros();
+
+    // Locate the delta blocks unless the content was just scanned, an invalid copy is read without them
+    if (!eepromContentValid) {
+        isEEPROMContentValid();
+    }
+
+    const uint8_t *cursor = &__config_start + sizeof(configHeader_t);
+
     PG_FOREACH(reg) {
         configRecordFlags_e cls_start, cls_end;
         if (pgIsSystem(reg)) {
@@ -224,7 +365,7 @@ bool loadEEPROM(void)
         }
         for (configRecordFlags_e cls = cls_start; cls <= cls_end; cls++) {
             int profileIndex = cls - cls_start;
-            const configRecord_t *rec = findEEPROM(reg, cls);
+            const configRecord_t *rec = nextEEPROMRecord(&cursor, reg, cls);
             if (rec) {
                 // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
                 pgLoad(reg, profileIndex, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
@@ -233,9 +374,161 @@ bool loadEEPROM(void)
             }
         }
     }
+
+    if (eepromJournalStart) {
+        for (const uint8_t *p = eepromJournalStart; p < eepromJournalEnd; p += ((const configJournalHeader_t *)p)->size) {
+            for (const uint8_t *r = p + sizeof(configJournalHeader_t); ((const configRecord_t *)r)->size != 0; r += ((const configRecord_t *)r)->size) {
+                const configRecord_t *rec = (const configRecord_t *)r;
+                const pgRegistry_t *reg = pgFind(rec->pgn);
+                const configRecordFlags_e cls = rec->flags & CR_CLASSIFICATION_MASK;
+                if (!reg || (pgIsSystem(reg) != (cls == CR_CLASSICATION_SYSTEM))) {
+                    continue;
+                }
+                const int profileIndex = pgIsSystem(reg) ? 0 : cls - CR_CLASSICATION_PROFILE1;
+                pgLoad(reg, profileIndex, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
+            }
+        }
+    }
+
+    eepromLoadTimeUs = micros() - startTimeUs;
     return true;
 }
 
+static bool writeRecordToEEPROM(config_streamer_t *streamer, uint16_t *crc, const configRecord_t *record, const void *data)
+{
+    if (config_streamer_write(streamer, (const uint8_t *)record, sizeof(*record)) < 0) {
+        return false;
+    }
+    *crc = crc16_ccitt_update(*crc, record, sizeof(*record));
+    if (config_streamer_write(streamer, data, record->size - sizeof(*record)) < 0) {
+        return false;
+    }
+    *crc = crc16_ccitt_update(*crc, data, record->size - sizeof(*record));
+    return true;
+}
+
+static bool writeFooterToEEPROM(config_streamer_t *streamer, uint16_t crc)
+{
+    configFooter_t footer = {
+        .terminator = 0,
+    };
+
+    if (config_streamer_write(streamer, (uint8_t *)&footer, sizeof(footer)) < 0) {
+        return false;
+    }
+    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
+
+    // append checksum now
+    if (config_streamer_write(streamer, (uint8_t *)&crc, sizeof(crc)) < 0) {
+        return false;
+    }
+
+    if (config_streamer_flush(streamer) < 0) {
+        return false;
+    }
+
+    return config_streamer_finish(streamer) == 0;
+}
+
+// Returns true when the stored copy of the PG instance differs from the one in RAM
+static bool isRecordChanged(const pgRegistry_t *reg, configRecordFlags_e classification, const uint8_t *address)
+{
+    const configRecord_t *stored = findEEPROM(reg, classification);
+    const uint16_t regSize = pgSize(reg);
+
+    return !stored || stored->version != pgVersion(reg) || stored->size != sizeof(configRecord_t) + regSize || memcmp(stored->pg, address, regSize) != 0;
+}
+
+// Flash words can only be programmed once after an erase. The space a block is appended to has to
+// be erased, a block torn by a power loss during a save leaves some of it programmed. Only the
+// range the block goes to is checked, stale blocks further on in a partition spanning several
+// sectors are not erased by a rewrite and must not keep the journal disabled.
+static bool isEEPROMErased(const uint8_t *p, const uint8_t *end)
+{
+    for (; p < end; p++) {
+        if (*p != CONFIG_ERASED_BYTE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Append the PG instances changed since the last save as a delta block.
+// Returns false when the block can't be appended and the whole config has to be rewritten.
+static bool writeDeltaToEEPROM(void)
+{
+    if (!eepromJournalEnd) {
+        return false;
+    }
+
+    // Size the block first, it has to fit into the remaining space
+    uint32_t blockSize = sizeof(configJournalHeader_t);
+    PG_FOREACH(reg) {
+        const uint16_t regSize = pgSize(reg);
+        const int instances = pgIsSystem(reg) ? 1 : MAX_PROFILE_COUNT;
+        for (int profileIndex = 0; profileIndex < instances; profileIndex++) {
+            const configRecordFlags_e cls = pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : (profileIndex + 1);
+            if (isRecordChanged(reg, cls, reg->address + (regSize * profileIndex))) {
+                blockSize += sizeof(configRecord_t) + regSize;
+            }
+        }
+    }
+
+    if (blockSize == sizeof(configJournalHeader_t)) {
+        // Nothing changed since the last save
+        return true;
+    }
+
+    blockSize += sizeof(configFooter_t) + sizeof(uint16_t);
+    blockSize = alignToWriteSize(&__config_start + blockSize) - &__config_start;
+    if (blockSize > UINT16_MAX || eepromJournalEnd + blockSize > &__config_end) {
+        return false;
+    }
+
+    if (!isEEPROMErased(eepromJournalEnd, eepromJournalEnd + blockSize)) {
+        return false;
+    }
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+
+    config_streamer_start(&streamer, (uintptr_t)eepromJournalEnd, &__config_end - eepromJournalEnd);
+
+    configJournalHeader_t journal = {
+        .size = blockSize,
+        .generation = eepromGeneration,
+    };
+
+    if (config_streamer_write(&streamer, (uint8_t *)&journal, sizeof(journal)) < 0) {
+        return false;
+    }
+    uint16_t crc = crc16_ccitt_update(0, (uint8_t *)&journal, sizeof(journal));
+
+    PG_FOREACH(reg) {
+        const uint16_t regSize = pgSize(reg);
+        const int instances = pgIsSystem(reg) ? 1 : MAX_PROFILE_COUNT;
+        for (int profileIndex = 0; profileIndex < instances; profileIndex++) {
+            const configRecordFlags_e cls = pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : (profileIndex + 1);
+            const uint8_t *address = reg->address + (regSize * profileIndex);
+            if (!isRecordChanged(reg, cls, address)) {
+                continue;
+            }
+
+            const configRecord_t record = {
+                .size = sizeof(configRecord_t) + regSize,
+                .pgn = pgN(reg),
+                .version = pgVersion(reg),
+                .flags = cls
+            };
+            if (!writeRecordToEEPROM(&streamer, &crc, &record, address)) {
+                return false;
+            }
+        }
+    }
+
+    return writeFooterToEEPROM(&streamer, crc);
+}
+
 static bool writeSettingsToEEPROM(void)
 {
     config_streamer_t streamer;
@@ -251,6 +544,22 @@ static bool writeSettingsToEEPROM(void)
         return false;
     }
     uint16_t crc = crc16_ccitt_update(0, (uint8_t *)&header, sizeof(header));
+
+    // A new generation invalidates any delta blocks left behind the new copy
+    uint16_t generation = eepromGeneration + 1;
+    if (generation == 0 || generation == UINT16_MAX) {
+        generation = 1;
+    }
+    const configRecord_t generationRecord = {
+        .size = sizeof(configRecord_t) + sizeof(generation),
+        .pgn = CONFIG_GENERATION_PGN,
+        .version = 0,
+        .flags = CR_CLASSICATION_SYSTEM
+    };
+    if (!writeRecordToEEPROM(&streamer, &crc, &generationRecord, &generation)) {
+        return false;
+    }
+
     PG_FOREACH(reg) {
         const uint16_t regSize = pgSize(reg);
         configRecord_t record = {
@@ -290,32 +599,22 @@ static bool writeSettingsToEEPROM(void)
         }
     }
 
-    configFooter_t footer = {
-        .terminator = 0,
-    };
-
-    if (config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer)) < 0) {
-        return false;
-    }
-    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
-
-    // append checksum now
-    if (config_streamer_write(&streamer, (uint8_t *)&crc, sizeof(crc)) < 0) {
-        return false;
-    }
-
-    if (config_streamer_flush(&streamer) < 0) {
-        return false;
-    }
-
-    bool success = config_streamer_finish(&streamer) == 0;
-
-    return success;
+    return writeFooterToEEPROM(&streamer, crc);
 }
 
 void writeConfigToEEPROM(void)
 {
-    bool success = false;
+    // Whatever was scanned before is about to change
+    eepromContentValid = false;
+
+    // Appending a delta is enough as long as it fits, otherwise compact into a fresh copy
+    bool success = isEEPROMContentValid() && writeDeltaToEEPROM();
+#ifdef CONFIG_IN_EXTERNAL_FLASH
+    if (success) {
+        success = loadEEPROMFromExternalFlash();
+    }
+#endif
+
     // write it
     for (int attempt = 0; attempt < 3 && !success; attempt++) {
         if (writeSettingsToEEPROM()) {
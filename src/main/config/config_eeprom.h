@@ -21,9 +21,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "common/time.h"
+
 #define EEPROM_CONF_VERSION 126
 
 bool isEEPROMContentValid(void);
 bool loadEEPROM(void);
 void writeConfigToEEPROM(void);
-uint16_t getEEPROMConfigSize(void);
+uint32_t getEEPROMConfigSize(void);
+timeDelta_t getEEPROMValidateTimeUs(void);
+timeDelta_t getEEPROMLoadTimeUs(void);
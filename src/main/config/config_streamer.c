@@ -21,7 +21,10 @@
 #include "config/config_streamer.h"
 #include "build/build_config.h"
 
-#if !defined(CONFIG_IN_FLASH)
+#if defined(CONFIG_IN_FILE)
+// Page aligned so the config file can be mapped in place, 16K covers all host page sizes
+uint8_t eepromData[EEPROM_SIZE] __attribute__((aligned(16384)));
+#elif !defined(CONFIG_IN_FLASH)
 SLOW_RAM uint8_t eepromData[EEPROM_SIZE];
 #endif
 
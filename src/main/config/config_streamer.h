@@ -36,6 +36,9 @@ typedef uint64_t config_streamer_buffer_align_type_t;
 typedef uint32_t config_streamer_buffer_align_type_t;
 #endif
 
+// Value of erased config memory, the streamers for RAM and file emulate the flash erase
+#define CONFIG_ERASED_BYTE 0xFF
+
 typedef struct config_streamer_s {
     uintptr_t address;
     uintptr_t end;
@@ -60,4 +63,5 @@ int config_streamer_status(config_streamer_t *c);
 
 #if defined(CONFIG_IN_FILE)
 bool configFileSetPath(char* path);
+void configFileSetShared(bool shared);
 #endif
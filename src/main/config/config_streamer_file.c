@@ -26,12 +26,18 @@
 
 #include <stdio.h>
 #include <errno.h>
-
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define FLASH_PAGE_SIZE  (0x400)
 
-static FILE *eepromFd = NULL;
+static int eepromFd = -1;
+static bool eepromMapped = false;
+static bool eepromShared = false;
 static bool streamerLocked = true;
+static uint32_t eepromBytesWritten;
 static char eepromPath[260] = EEPROM_FILENAME;
 
 bool configFileSetPath(char* path)
@@ -44,54 +50,92 @@ bool configFileSetPath(char* path)
     return true;
 }
 
-void config_streamer_impl_unlock(void)
+void configFileSetShared(bool shared)
 {
-    if (eepromFd != NULL) {
-        fprintf(stderr, "[EEPROM] Unable to load %s\n", eepromPath);
-        return;
+    eepromShared = shared;
+}
+
+// Map the config file over eepromData, so the config streamer writes straight into the page cache.
+// A shared file is mapped copy-on-write: instances share its pages until they save, and saves are never written back.
+static bool configFileOpen(void)
+{
+    eepromFd = open(eepromPath, (eepromShared ? O_RDONLY : O_RDWR | O_CREAT) | O_CLOEXEC, 0644);
+    if (eepromFd < 0) {
+        fprintf(stderr, "[EEPROM] Failed to open '%s': %s\n", eepromPath, strerror(errno));
+        return false;
     }
 
-    // open or create
-    eepromFd = fopen(eepromPath,"r+");
-    if (eepromFd != NULL) {
-        // obtain file size:
-        fseek(eepromFd , 0 , SEEK_END);
-        size_t size = ftell(eepromFd);
-        rewind(eepromFd);
-
-        size_t n = fread(eepromData, 1, sizeof(eepromData), eepromFd);
-        if (n == size) {
-            fprintf(stderr,"[EEPROM] Loaded '%s' (%ld of %ld bytes)\n", eepromPath, size, sizeof(eepromData));
-            streamerLocked = false;
-        } else {
-            fprintf(stderr, "[EEPROM] Failed to load '%s'\n", eepromPath);
-        }
-    } else {
-        printf("[EEPROM] Created '%s', size = %ld\n", eepromPath, sizeof(eepromData));
-        streamerLocked = false;
-        if ((eepromFd = fopen(eepromPath, "w+")) == NULL) {
-            fprintf(stderr, "[EEPROM] Failed to create '%s'\n", eepromPath);
-            streamerLocked = true;
-        }
-        if (fwrite(eepromData, sizeof(eepromData), 1, eepromFd) != 1) {
-            fprintf(stderr, "[EEPROM] Write failed: %s\n", strerror(errno));
-            streamerLocked = true;
+    struct stat st;
+    if (fstat(eepromFd, &st) != 0) {
+        st.st_size = 0;
+    }
+
+    const bool created = st.st_size == 0;
+    if ((size_t)st.st_size < sizeof(eepromData)) {
+        // Pages beyond the end of the file can't be mapped
+        if (eepromShared || ftruncate(eepromFd, sizeof(eepromData)) != 0) {
+            fprintf(stderr, "[EEPROM] '%s' is too small (%ld of %ld bytes)\n", eepromPath, (long)st.st_size, sizeof(eepromData));
+            close(eepromFd);
+            eepromFd = -1;
+            return false;
         }
     }
+
+    // eepromData is page aligned, but mapping in place is not supported everywhere, keep a copy in memory then
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize > 0 && ((uintptr_t)eepromData % pageSize) == 0 && (sizeof(eepromData) % pageSize) == 0) {
+        void *mapping = mmap(eepromData, sizeof(eepromData), PROT_READ | PROT_WRITE, MAP_FIXED | (eepromShared ? MAP_PRIVATE : MAP_SHARED), eepromFd, 0);
+        eepromMapped = (mapping == (void *)eepromData);
+    }
+
+    if (!eepromMapped && pread(eepromFd, eepromData, sizeof(eepromData), 0) != (ssize_t)sizeof(eepromData)) {
+        fprintf(stderr, "[EEPROM] Failed to load '%s'\n", eepromPath);
+        close(eepromFd);
+        eepromFd = -1;
+        return false;
+    }
+
+    fprintf(stderr, "[EEPROM] %s '%s' (%ld bytes, %s)\n", created ? "Created" : "Loaded", eepromPath, sizeof(eepromData),
+        eepromMapped ? (eepromShared ? "mapped copy-on-write" : "mapped") : "buffered");
+    return true;
+}
+
+void config_streamer_impl_unlock(void)
+{
+    if (eepromFd < 0 && !configFileOpen()) {
+        return;
+    }
+
+    eepromBytesWritten = 0;
+    streamerLocked = false;
 }
 
 void config_streamer_impl_lock(void)
 {
-    // flush & close
-    if (eepromFd != NULL) {
-        fseek(eepromFd, 0, SEEK_SET);
-        fwrite(eepromData, 1, sizeof(eepromData), eepromFd);
-        fclose(eepromFd);
-        eepromFd = NULL;
-        fprintf(stderr, "[EEPROM] Saved '%s'\n", eepromPath);
-        streamerLocked = false;
-    } else {
+    if (streamerLocked) {
         fprintf(stderr, "[EEPROM] Unlock error\n");
+        return;
+    }
+
+    streamerLocked = true;
+
+    if (eepromShared) {
+        fprintf(stderr, "[EEPROM] Kept %u bytes in memory, '%s' is shared and not written\n", eepromBytesWritten, eepromPath);
+        return;
+    }
+
+    // One sync per save, whatever the number of words written
+    bool success;
+    if (eepromMapped) {
+        success = msync(eepromData, sizeof(eepromData), MS_SYNC) == 0;
+    } else {
+        success = pwrite(eepromFd, eepromData, sizeof(eepromData), 0) == (ssize_t)sizeof(eepromData);
+    }
+
+    if (success) {
+        fprintf(stderr, "[EEPROM] Saved '%s' (%u bytes written)\n", eepromPath, eepromBytesWritten);
+    } else {
+        fprintf(stderr, "[EEPROM] Write failed: %s\n", strerror(errno));
     }
 }
 
@@ -101,13 +145,19 @@ int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer
         return -1;
     }
 
-    if ((c->address >= (uintptr_t)eepromData) && (c->address < (uintptr_t)ARRAYEND(eepromData))) {
-        *((uint32_t*)c->address) = *buffer;
-        fprintf(stderr, "[EEPROM] Program word  %p = %08x\n", (void*)c->address, *((uint32_t*)c->address));
-    } else {
+    if ((c->address < (uintptr_t)eepromData) || (c->address + CONFIG_STREAMER_BUFFER_SIZE > (uintptr_t)ARRAYEND(eepromData))) {
         fprintf(stderr, "[EEPROM] Program word %p out of range!\n", (void*)c->address);
+        return -2;
     }
 
+    // Rewriting from the start erases the whole file, like the flash sector
+    if (c->address == (uintptr_t)eepromData) {
+        memset(eepromData, CONFIG_ERASED_BYTE, sizeof(eepromData));
+    }
+
+    memcpy((void *)c->address, buffer, CONFIG_STREAMER_BUFFER_SIZE);
+    eepromBytesWritten += CONFIG_STREAMER_BUFFER_SIZE;
+
     c->address += CONFIG_STREAMER_BUFFER_SIZE;
     return 0;
 }
@@ -190,9 +190,15 @@
 // is faster than redrawing the whole screen on each frame.
 static BITARRAY_DECLARE(screenIsDirty, MAX7456_BUFFER_CHARS_PAL);
 
-//max chars to update in one idle
-#define MAX_CHARS2UPDATE        10
+// Max SPI bytes to send in one idle. Runs of characters with the same
+// attributes are sent in auto-increment mode (~1 byte per char), other
+// characters are addressed one by one (up to 7 register writes each).
+#define MAX7456_SPI_BUFF_SIZE   140
 #define BYTES_PER_CHAR2UPDATE   (7 * 2) // SPI regs + values for them
+#define BYTES_PER_RUN_OVERHEAD  (4 * 2 + 1) // DMAH, DMAL, DMM + END_STRING + DMM
+// Clean characters between two dirty ones are resent as part of the run
+// if that's cheaper than starting a new one.
+#define MAX_RUN_GAP             BYTES_PER_RUN_OVERHEAD
 
 typedef struct max7456Registers_s {
     uint8_t vm0;
@@ -483,18 +489,47 @@ void max7456Write(uint8_t x, uint8_t y, const char *buff, uint8_t mode)
     }
 }
 
+// Returns true iff the character can be sent as part of an auto-increment run
+// with the given attributes. Extended characters need the 8 bit mode and
+// END_STRING would terminate the run, so both are sent individually.
+static bool max7456CanAppendToRun(uint16_t val, uint8_t charMode)
+{
+    return !CHAR_MODE_IS_EXT(MODE_BYTE(val)) && MODE_BYTE(val) == charMode && CHAR_BYTE(val) != END_STRING;
+}
+
+// Returns the length of the run of characters starting at pos which can be
+// sent in auto-increment mode, without including trailing clean characters.
+static size_t max7456FindRunLength(size_t pos, uint8_t charMode, size_t maxLength)
+{
+    const size_t screenSize = ARRAYLEN(osdCharacterGridBuffer);
+    size_t length = 1;
+    size_t gap = 0;
+
+    for (size_t ii = pos + 1; ii < screenSize && ii - pos < maxLength; ii++) {
+        if (!max7456CanAppendToRun(osdCharacterGridBuffer[ii], charMode)) {
+            break;
+        }
+        if (bitArrayGet(screenIsDirty, ii)) {
+            length = ii - pos + 1;
+            gap = 0;
+        } else if (++gap > MAX_RUN_GAP) {
+            break;
+        }
+    }
+    return length;
+}
+
 // Must be called with the lock held. Returns whether any new characters
 // were drawn.
 static bool max7456DrawScreenPartial(void)
 {
-    uint8_t spiBuff[MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE];
+    uint8_t spiBuff[MAX7456_SPI_BUFF_SIZE];
     int bufPtr = 0;
     size_t pos;
-    uint_fast16_t updatedCharCount;
     uint8_t charMode;
     int next;
 
-    for (pos = 0, updatedCharCount = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
+    for (pos = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
         next = BITARRAY_FIND_FIRST_SET(screenIsDirty, pos);
         if (next < 0) {
             // No more dirty chars.
@@ -511,6 +546,39 @@ static bool max7456DrawScreenPartial(void)
 
         charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
         uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
+        if (max7456CanAppendToRun(osdCharacterGridBuffer[pos], charMode)) {
+            if (bufPtr + BYTES_PER_RUN_OVERHEAD + 1 > (int)sizeof(spiBuff)) {
+                break;
+            }
+
+            size_t runLength = max7456FindRunLength(pos, charMode, sizeof(spiBuff) - bufPtr - BYTES_PER_RUN_OVERHEAD);
+
+            state.registers.dmm &= ~DMM_8BIT_MODE;
+            state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
+
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
+            // The attributes in DMM apply to all the characters in the run. In
+            // auto-increment mode each following byte is written to DMDI and
+            // the display memory address advances, until END_STRING is sent.
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm | DMM_AUTOINCREMENT);
+            for (size_t ii = 0; ii < runLength; ii++, pos++) {
+                spiBuff[bufPtr++] = CHAR_BYTE(osdCharacterGridBuffer[pos]);
+                bitArrayClr(screenIsDirty, pos);
+            }
+            spiBuff[bufPtr++] = END_STRING;
+            // END_STRING should leave auto-increment mode, but don't rely on it:
+            // rewrite DMM so the next DMAH/DMAL can't be taken as characters and
+            // the chip matches the cached register again.
+            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+            // Next search starts right after the run
+            continue;
+        }
+
+        if (bufPtr + BYTES_PER_CHAR2UPDATE > (int)sizeof(spiBuff)) {
+            break;
+        }
+
         if (CHAR_MODE_IS_EXT(charMode)) {
             if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
                 state.registers.dmm |= DMM_8BIT_MODE;
@@ -531,12 +599,10 @@ static bool max7456DrawScreenPartial(void)
             bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
 
         } else {
+            // END_STRING with regular attributes, can't be part of a run
             if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
                 state.registers.dmm &= ~DMM_8BIT_MODE;
                 state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
-                // Send the attributes for the character run. They
-                // will be applied to all characters until we change
-                // the DMM register.
                 bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
             }
 
@@ -546,9 +612,6 @@ static bool max7456DrawScreenPartial(void)
         }
 
         bitArrayClr(screenIsDirty, pos);
-        if (++updatedCharCount == MAX_CHARS2UPDATE) {
-            break;
-        }
         // Start next search at next bit
         pos++;
     }
@@ -214,7 +214,8 @@ static const char *debugModeNames[DEBUG_COUNT] = {
     "HEADTRACKER",
     "GPS",
     "LULU",
-    "SBUS2"
+    "SBUS2",
+    "WIND"
 };
 
 /* Sensor names (used in lookup tables for *_hardware settings and in status
@@ -276,6 +277,8 @@ static void cliPrintLinefeed(void)
 {
     cliPrint("\r\n");
     if (cliDelayMs) {
+        // Pace the output line by line for slow receivers
+        bufWriterFlush(cliWriter);
         delay(cliDelayMs);
     }
 }
@@ -337,16 +340,16 @@ typedef enum {
     HIDE_UNUSED = (1 << 7)
 } dumpFlags_e;
 
+// Output is only written to the port once the buffer fills up or the command completes,
+// so long dumps go out in full buffer sized writes instead of one write per print
 static void cliPrintfva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
 }
 
 static void cliPrintLinefva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
     cliPrintLinefeed();
 }
 
@@ -559,7 +562,6 @@ static void dumpAllValues(uint16_t valueSection, uint8_t dumpMask)
 {
     for (unsigned i = 0; i < SETTINGS_TABLE_COUNT; i++) {
         const setting_t *value = settingGet(i);
-        bufWriterFlush(cliWriter);
         if (SETTING_SECTION(value) == valueSection) {
             dumpPgValue(value, dumpMask);
         }
@@ -954,6 +956,9 @@ static void cliSerialPassthrough(char *cmdline)
 {
     char * saveptr;
 
+    // Messages below bypass the CLI buffer
+    bufWriterFlush(cliWriter);
+
     if (isEmpty(cmdline)) {
         cliShowParseError();
         return;
@@ -2953,6 +2958,8 @@ static void cliFlashErase(char *cmdline)
     }
 
     cliPrintLine("Erasing...");
+    // The erase blocks for a long time, show the message before it starts
+    bufWriterFlush(cliWriter);
     flashfsEraseCompletely();
 
     while (!flashIsReady()) {
@@ -3619,6 +3626,7 @@ static void cliGpsPassthrough(char *cmdline)
 {
     UNUSED(cmdline);
 
+    bufWriterFlush(cliWriter);
     gpsEnablePassthrough(cliPort);
 }
 #endif
@@ -3844,6 +3852,7 @@ static void cliSave(char *cmdline)
 #endif
 
     cliPrint("Saving");
+    bufWriterFlush(cliWriter);
     //copyCurrentProfileToProfileSlot(getConfigProfile();
     suspendRxSignal();
     writeEEPROM();
@@ -3856,6 +3865,7 @@ static void cliDefaults(char *cmdline)
     UNUSED(cmdline);
 
     cliPrint("Resetting to defaults");
+    bufWriterFlush(cliWriter);
     resetEEPROM();
     suspendRxSignal();
     writeEEPROM();
@@ -4138,6 +4148,7 @@ static void cliStatus(char *cmdline)
 
     cliPrintLinef("I2C Errors: %d, config size: %d, max available config: %d", i2cErrorCounter, getEEPROMConfigSize(), &__config_end - &__config_start);
 #endif
+    cliPrintLinef("Config load time: %dus, validation: %dus", getEEPROMLoadTimeUs(), getEEPROMValidateTimeUs());
 #if defined(USE_ADC) && !defined(SITL_BUILD)
     static char * adcFunctions[] = { "BATTERY", "RSSI", "CURRENT", "AIRSPEED" };
     cliPrintLine("ADC channel usage:");
@@ -4378,6 +4389,13 @@ static void restoreConfigs(void)
     }
 }
 
+/*
+ * Runs to completion in one call. While it runs the live config holds the defaults
+ * (the user's values are in the PG copies) and the profile dumps switch the active
+ * profile, so handing control back to the scheduler halfway would run the other
+ * tasks on that state. Splitting a dump across calls needs the section printers to
+ * compare against a separate defaults copy instead.
+ */
 static void printConfig(const char *cmdline, bool doDiff)
 {
     uint8_t dumpMask = DUMP_MASTER;
@@ -119,6 +119,7 @@ int16_t headFreeModeHold;
 uint8_t motorControlEnable = false;
 
 static bool isRXDataNew;
+static bool isRXFramePending;       // rx_pid_sync: channels already updated by the PID loop, rest of the frame handling left to TASK_RX
 static disarmReason_t lastDisarmReason = DISARM_NONE;
 timeUs_t lastDisarmTimeUs = 0;
 timeMs_t emergRearmStabiliseTimeout = 0;
@@ -630,9 +631,6 @@ void releaseSharedTelemetryPorts(void) {
 
 void processRx(timeUs_t currentTimeUs)
 {
-    // Calculate RPY channel data
-    calculateRxChannelsAndUpdateFailsafe(currentTimeUs);
-
     // in 3D mode, we need to be able to disarm by switch at any time
     if (feature(FEATURE_REVERSIBLE_MOTORS)) {
         if (!IS_RC_MODE_ACTIVE(BOXARM)) {
@@ -922,6 +920,14 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
     }
 #endif
 
+    if (rxConfig()->pidSync && rxUpdateCheck(currentTimeUs, cycleTime)) {
+        // Only decode the channels here so the new sticks reach rcCommand in this iteration.
+        // Stick commands, failsafe and mode changes are left to TASK_RX.
+        calculateRxChannelsAndUpdateFailsafe(currentTimeUs);
+        isRXDataNew = true;
+        isRXFramePending = true;
+    }
+
     processPilotAndFailSafeActions(dT);
 
     updateArmingStatus();
@@ -1011,11 +1017,23 @@ bool taskUpdateRxCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
 {
     UNUSED(currentDeltaTime);
 
+    // With rx_pid_sync the PID loop polls the receiver
+    if (rxConfig()->pidSync) {
+        return isRXFramePending;
+    }
+
     return rxUpdateCheck(currentTimeUs, currentDeltaTime);
 }
 
 void taskUpdateRxMain(timeUs_t currentTimeUs)
 {
+    if (rxConfig()->pidSync) {
+        isRXFramePending = false;
+    } else {
+        // Calculate RPY channel data
+        calculateRxChannelsAndUpdateFailsafe(currentTimeUs);
+    }
+
     processRx(currentTimeUs);
     isRXDataNew = true;
 }
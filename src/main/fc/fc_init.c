@@ -100,6 +100,7 @@
 #include "flight/ez_tune.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
+#include "io/adsb.h"
 #include "io/beeper.h"
 #include "io/lights.h"
 #include "io/dashboard.h"
@@ -596,6 +597,10 @@ void init(void)
 
     navigationInit();
 
+#ifdef USE_ADSB
+    adsbInit();
+#endif
+
 #ifdef USE_LED_STRIP
     ledStripInit();
 
@@ -67,10 +67,12 @@
 #include "fc/controlrate_profile.h"
 #include "fc/fc_msp.h"
 #include "fc/fc_msp_box.h"
+#include "fc/fc_msp_wp.h"
 #include "fc/firmware_update.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
+#include "fc/rc_smoothing.h"
 #include "fc/runtime_config.h"
 #include "fc/settings.h"
 
@@ -181,6 +183,11 @@ typedef enum {
     MSP_PASSTHROUGH_ESC_4WAY           = 0xFF,
  } mspPassthroughType_e;
 
+#ifdef USE_ADSB
+// Callsign, icao, lat, lon, alt, heading, tslc, emitter type, ttl
+#define MSP_ADSB_VEHICLE_SIZE       (ADSB_CALL_SIGN_MAX_LENGTH + 4 * 4 + 2 + 3)
+#endif
+
 static uint8_t mspPassthroughMode;
 static uint8_t mspPassthroughArgument;
 
@@ -955,14 +962,28 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
 #endif
     case MSP2_ADSB_VEHICLE_LIST:
 #ifdef USE_ADSB
-        sbufWriteU8(dst, MAX_ADSB_VEHICLES);
+    {
+        // Table may be larger than a reply, send the most relevant vehicles that fit
+        adsbVehicle_t *adsbVehicles[MAX_ADSB_VEHICLES];
+        const uint8_t maxVehicles = MIN(MAX_ADSB_VEHICLES, (sbufBytesRemaining(dst) - 10) / MSP_ADSB_VEHICLE_SIZE);
+        const uint8_t vehiclesCount = findVehiclesClosest(adsbVehicles, maxVehicles);
+
+        sbufWriteU8(dst, maxVehicles);
         sbufWriteU8(dst, ADSB_CALL_SIGN_MAX_LENGTH);
         sbufWriteU32(dst, getAdsbStatus()->vehiclesMessagesTotal);
         sbufWriteU32(dst, getAdsbStatus()->heartbeatMessagesTotal);
 
-        for(uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++){
+        for(uint8_t i = 0; i < maxVehicles; i++){
+
+            if (i >= vehiclesCount) {
+                // Empty slot, ttl = 0
+                for (uint8_t ii = 0; ii < MSP_ADSB_VEHICLE_SIZE; ii++) {
+                    sbufWriteU8(dst, 0);
+                }
+                continue;
+            }
 
-            adsbVehicle_t *adsbVehicle = findVehicle(i);
+            adsbVehicle_t *adsbVehicle = adsbVehicles[i];
 
             for(uint8_t ii = 0; ii < ADSB_CALL_SIGN_MAX_LENGTH; ii++){
                 sbufWriteU8(dst, adsbVehicle->vehicleValues.callsign[ii]);
@@ -977,6 +998,7 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
             sbufWriteU8(dst,  adsbVehicle->vehicleValues.emitterType);
             sbufWriteU8(dst,  adsbVehicle->ttl);
         }
+    }
 #else
         sbufWriteU8(dst, 0);
         sbufWriteU8(dst, 0);
@@ -1671,6 +1693,16 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         break;
 #endif
 
+    case MSP2_INAV_RX_FRAME_TIMING:
+        {
+            const rxFrameTiming_t *timing = rxGetFrameTiming();
+            sbufWriteU32(dst, timing->intervalUs);
+            sbufWriteU32(dst, timing->latencyUs);
+            sbufWriteU16(dst, timing->jitterUs);
+            sbufWriteU16(dst, getRcUpdateFrequency());
+        }
+        break;
+
 #ifdef USE_ESC_SENSOR
     case MSP2_INAV_ESC_RPM:
         {
@@ -1850,14 +1882,7 @@ static void mspFcWaypointOutCommand(sbuf_t *dst, sbuf_t *src)
     navWaypoint_t msp_wp;
     getWaypoint(msp_wp_no, &msp_wp);
     sbufWriteU8(dst, msp_wp_no);      // wp_no
-    sbufWriteU8(dst, msp_wp.action);  // action (WAYPOINT)
-    sbufWriteU32(dst, msp_wp.lat);    // lat
-    sbufWriteU32(dst, msp_wp.lon);    // lon
-    sbufWriteU32(dst, msp_wp.alt);    // altitude (cm)
-    sbufWriteU16(dst, msp_wp.p1);     // P1
-    sbufWriteU16(dst, msp_wp.p2);     // P2
-    sbufWriteU16(dst, msp_wp.p3);     // P3
-    sbufWriteU8(dst, msp_wp.flag);    // flags
+    mspSerializeWaypoint(dst, &msp_wp);
 }
 
 #ifdef USE_FLASHFS
@@ -2854,33 +2879,17 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
 
             const uint8_t msp_wp_no = sbufReadU8(src);     // get the waypoint number
             navWaypoint_t msp_wp;
-            msp_wp.action = sbufReadU8(src);    // action
-            msp_wp.lat = sbufReadU32(src);      // lat
-            msp_wp.lon = sbufReadU32(src);      // lon
-            msp_wp.alt = sbufReadU32(src);      // to set altitude (cm)
-            msp_wp.p1 = sbufReadU16(src);       // P1
-            msp_wp.p2 = sbufReadU16(src);       // P2
-            msp_wp.p3 = sbufReadU16(src);       // P3
-            msp_wp.flag = sbufReadU8(src);      // future: to set nav flag
-            setWaypoint(msp_wp_no, &msp_wp);
-
-#ifdef USE_FW_AUTOLAND
-            static uint8_t mmIdx = 0, fwAppraochStartIdx = 8;
-#ifdef USE_SAFE_HOME
-            fwAppraochStartIdx = MAX_SAFE_HOMES;
-#endif
-            if (msp_wp_no == 0) {
-                mmIdx = 0;
-            } else if (msp_wp.flag == NAV_WP_FLAG_LAST) {
-                mmIdx++;
-            }
-            resetFwAutolandApproach(fwAppraochStartIdx + mmIdx);
-#endif
+            mspDeserializeWaypoint(src, &msp_wp);
+            mspFcSetWaypoint(msp_wp_no, &msp_wp);
         } else {
             return MSP_RESULT_ERROR;
         }
 
         break;
+
+    case MSP2_INAV_SET_WP_BATCH:
+        return mspFcWaypointBatchInCommand(src, dataSize);
+
     case MSP2_COMMON_SET_RADAR_POS:
         if (dataSize == 19) {
             const uint8_t msp_radar_no = MIN(sbufReadU8(src), RADAR_MAX_POIS - 1); // Radar poi number, 0 to 3
@@ -3605,15 +3614,11 @@ static bool mspSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
-static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+// Reads a value for the given setting from src and checks it against
+// the setting limits. The value is only stored when apply is true, so
+// callers can validate a whole batch before changing anything.
+static bool mspReadSettingValue(const setting_t *setting, sbuf_t *src, bool apply)
 {
-    UNUSED(dst);
-
-    const setting_t *setting = mspReadSetting(src);
-    if (!setting) {
-        return false;
-    }
-
     setting_min_t min = settingGetMin(setting);
     setting_max_t max = settingGetMax(setting);
 
@@ -3628,7 +3633,9 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val > max) {
                     return false;
                 }
-                *((uint8_t*)ptr) = val;
+                if (apply) {
+                    *((uint8_t*)ptr) = val;
+                }
             }
             break;
         case VAR_INT8:
@@ -3640,7 +3647,9 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val < min || val > (int8_t)max) {
                     return false;
                 }
-                *((int8_t*)ptr) = val;
+                if (apply) {
+                    *((int8_t*)ptr) = val;
+                }
             }
             break;
         case VAR_UINT16:
@@ -3652,7 +3661,9 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val > max) {
                     return false;
                 }
-                *((uint16_t*)ptr) = val;
+                if (apply) {
+                    *((uint16_t*)ptr) = val;
+                }
             }
             break;
         case VAR_INT16:
@@ -3664,7 +3675,9 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val < min || val > (int16_t)max) {
                     return false;
                 }
-                *((int16_t*)ptr) = val;
+                if (apply) {
+                    *((int16_t*)ptr) = val;
+                }
             }
             break;
         case VAR_UINT32:
@@ -3676,7 +3689,9 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val > max) {
                     return false;
                 }
-                *((uint32_t*)ptr) = val;
+                if (apply) {
+                    *((uint32_t*)ptr) = val;
+                }
             }
             break;
         case VAR_FLOAT:
@@ -3688,12 +3703,22 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (val < (float)min || val > (float)max) {
                     return false;
                 }
-                *((float*)ptr) = val;
+                if (apply) {
+                    *((float*)ptr) = val;
+                }
             }
             break;
         case VAR_STRING:
             {
-                settingSetString(setting, (const char*)sbufPtr(src), sbufBytesRemaining(src));
+                // Length prefixed, so several values can share a frame
+                uint8_t len;
+                if (!sbufReadU8Safe(&len, src) || len > max || len > sbufBytesRemaining(src)) {
+                    return false;
+                }
+                if (apply) {
+                    settingSetString(setting, (const char*)sbufPtr(src), len);
+                }
+                sbufAdvance(src, len);
             }
             break;
     }
@@ -3701,6 +3726,24 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+{
+    UNUSED(dst);
+
+    const setting_t *setting = mspReadSetting(src);
+    if (!setting) {
+        return false;
+    }
+
+    if (SETTING_TYPE(setting) == VAR_STRING) {
+        // Strings take the rest of the payload
+        settingSetString(setting, (const char*)sbufPtr(src), sbufBytesRemaining(src));
+        return true;
+    }
+
+    return mspReadSettingValue(setting, src, true);
+}
+
 static bool mspSettingInfoCommand(sbuf_t *dst, sbuf_t *src)
 {
     const setting_t *setting = mspReadSetting(src);
@@ -3799,6 +3842,98 @@ static bool mspParameterGroupsCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+static bool mspSettingsBatchCommand(sbuf_t *dst, sbuf_t *src)
+{
+    uint16_t first;
+    uint16_t last;
+
+    // Request payload:
+    //  uint16_t    - PG id, to read all the settings in that PG
+    // or
+    //  uint16_t    - index of the first setting
+    //  uint16_t    - number of settings to read
+    if (sbufBytesRemaining(src) == 2) {
+        if (!settingsGetParameterGroupIndexes(sbufReadU16(src), &first, &last)) {
+            return false;
+        }
+    } else {
+        uint16_t count;
+        if (!sbufReadU16Safe(&first, src) || !sbufReadU16Safe(&count, src) || count == 0) {
+            return false;
+        }
+        last = first + count - 1;
+    }
+
+    if (!settingGet(first)) {
+        return false;
+    }
+
+    // Reply: first index and count, then for each setting its type byte
+    // (type, section and mode) followed by the raw value. Strings are sent
+    // length prefixed. The reply stops at whatever fits, so callers continue
+    // from first + count.
+    sbufWriteU16(dst, first);
+    sbuf_t countBuf = *dst;
+    sbufWriteU16(dst, 0);
+
+    uint16_t count = 0;
+    for (unsigned ii = first; ii <= last; ii++) {
+        const setting_t *setting = settingGet(ii);
+        if (!setting) {
+            break;
+        }
+        const void *ptr = settingGetValuePointer(setting);
+        size_t size = settingGetValueSize(setting);
+        if (SETTING_TYPE(setting) == VAR_STRING) {
+            size = strlen(ptr);
+            if (sbufBytesRemaining(dst) < (int)size + 2) {
+                break;
+            }
+            sbufWriteU8(dst, setting->type);
+            sbufWriteU8(dst, size);
+        } else {
+            if (sbufBytesRemaining(dst) < (int)size + 1) {
+                break;
+            }
+            sbufWriteU8(dst, setting->type);
+        }
+        sbufWriteData(dst, ptr, size);
+        count++;
+    }
+
+    sbufWriteU16(&countBuf, count);
+    return true;
+}
+
+static bool mspSetSettingsBatchCommand(sbuf_t *dst, sbuf_t *src)
+{
+    // Request payload is a list of:
+    //  uint16_t    - setting index
+    //  value       - raw value, strings are length prefixed
+    // The whole list is validated before any value is changed, so a bad
+    // entry leaves the configuration untouched.
+    for (int pass = 0; pass < 2; pass++) {
+        const bool apply = pass == 1;
+        sbuf_t entries = *src;
+        uint16_t count = 0;
+        while (sbufBytesRemaining(&entries) > 0) {
+            uint16_t index;
+            if (!sbufReadU16Safe(&index, &entries)) {
+                return false;
+            }
+            const setting_t *setting = settingGet(index);
+            if (!setting || !mspReadSettingValue(setting, &entries, apply)) {
+                return false;
+            }
+            count++;
+        }
+        if (apply) {
+            sbufWriteU16(dst, count);
+        }
+    }
+    return true;
+}
+
 #ifdef USE_SIMULATOR
 bool isOSDTypeSupportedBySimulator(void)
 {
@@ -3959,6 +4094,10 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         *ret = MSP_RESULT_ACK;
         break;
 
+    case MSP2_INAV_WP_BATCH:
+        *ret = mspFcWaypointBatchOutCommand(dst, src);
+        break;
+
 #if defined(USE_FLASHFS)
     case MSP_DATAFLASH_READ:
         mspFcDataFlashReadCommand(dst, src);
@@ -3982,6 +4121,14 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         *ret = mspParameterGroupsCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
         break;
 
+    case MSP2_COMMON_SETTINGS_BATCH:
+        *ret = mspSettingsBatchCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
+    case MSP2_COMMON_SET_SETTINGS_BATCH:
+        *ret = mspSetSettingsBatchCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
 #if defined(USE_OSD)
     case MSP2_INAV_OSD_LAYOUTS:
         if (sbufBytesRemaining(src) >= 1) {
@@ -0,0 +1,129 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+#include "common/streambuf.h"
+#include "common/utils.h"
+
+#include "fc/fc_msp_wp.h"
+
+#include "navigation/navigation.h"
+
+void mspSerializeWaypoint(sbuf_t *dst, const navWaypoint_t *wp)
+{
+    sbufWriteU8(dst, wp->action);   // action (WAYPOINT)
+    sbufWriteU32(dst, wp->lat);     // lat
+    sbufWriteU32(dst, wp->lon);     // lon
+    sbufWriteU32(dst, wp->alt);     // altitude (cm)
+    sbufWriteU16(dst, wp->p1);      // P1
+    sbufWriteU16(dst, wp->p2);      // P2
+    sbufWriteU16(dst, wp->p3);      // P3
+    sbufWriteU8(dst, wp->flag);     // flags
+}
+
+void mspDeserializeWaypoint(sbuf_t *src, navWaypoint_t *wp)
+{
+    wp->action = sbufReadU8(src);   // action
+    wp->lat = sbufReadU32(src);     // lat
+    wp->lon = sbufReadU32(src);     // lon
+    wp->alt = sbufReadU32(src);     // to set altitude (cm)
+    wp->p1 = sbufReadU16(src);      // P1
+    wp->p2 = sbufReadU16(src);      // P2
+    wp->p3 = sbufReadU16(src);      // P3
+    wp->flag = sbufReadU8(src);     // future: to set nav flag
+}
+
+bool mspFcSetWaypoint(uint8_t wpNumber, const navWaypoint_t *wp)
+{
+    const bool accepted = setWaypoint(wpNumber, wp);
+
+#ifdef USE_FW_AUTOLAND
+    static uint8_t mmIdx = 0, fwAppraochStartIdx = 8;
+#ifdef USE_SAFE_HOME
+    fwAppraochStartIdx = MAX_SAFE_HOMES;
+#endif
+    if (wpNumber == 0) {
+        mmIdx = 0;
+    } else if (wp->flag == NAV_WP_FLAG_LAST) {
+        mmIdx++;
+    }
+    resetFwAutolandApproach(fwAppraochStartIdx + mmIdx);
+#endif
+
+    return accepted;
+}
+
+mspResult_e mspFcWaypointBatchOutCommand(sbuf_t *dst, sbuf_t *src)
+{
+    if (sbufBytesRemaining(src) < 2) {
+        return MSP_RESULT_ERROR;
+    }
+
+    const uint8_t firstWpNo = sbufReadU8(src);
+    const uint8_t requested = sbufReadU8(src);
+
+    if (firstWpNo < 1) {
+        return MSP_RESULT_ERROR;
+    }
+
+    // Never send more than the mission holds or the reply buffer fits
+    const int available = MAX(getWaypointCount() - (firstWpNo - 1), 0);
+    const int fitting = (sbufBytesRemaining(dst) - 2) / MSP_WP_BATCH_RECORD_SIZE;
+    const uint8_t count = MIN(MIN((int)requested, available), fitting);
+
+    sbufWriteU8(dst, firstWpNo);
+    sbufWriteU8(dst, count);
+    for (int i = 0; i < count; i++) {
+        navWaypoint_t msp_wp;
+        getWaypoint(firstWpNo + i, &msp_wp);
+        mspSerializeWaypoint(dst, &msp_wp);
+    }
+
+    return MSP_RESULT_ACK;
+}
+
+// First waypoint number followed by consecutive waypoints in MSP_WP layout
+mspResult_e mspFcWaypointBatchInCommand(sbuf_t *src, unsigned int dataSize)
+{
+    if (dataSize <= 1 || ((dataSize - 1) % MSP_WP_BATCH_RECORD_SIZE) != 0) {
+        return MSP_RESULT_ERROR;
+    }
+
+    const uint8_t firstWpNo = sbufReadU8(src);
+    const unsigned count = (dataSize - 1) / MSP_WP_BATCH_RECORD_SIZE;
+
+    if (firstWpNo < 1 || firstWpNo + count - 1 > NAV_MAX_WAYPOINTS) {
+        return MSP_RESULT_ERROR;
+    }
+
+    // Waypoints before a rejected one are already stored, but the mission is incomplete.
+    // Fail the whole batch so the GCS does not take a truncated upload for a good one.
+    for (unsigned i = 0; i < count; i++) {
+        navWaypoint_t msp_wp;
+        mspDeserializeWaypoint(src, &msp_wp);
+        if (!mspFcSetWaypoint(firstWpNo + i, &msp_wp)) {
+            return MSP_RESULT_ERROR;
+        }
+    }
+
+    return MSP_RESULT_ACK;
+}
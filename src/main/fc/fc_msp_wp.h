@@ -0,0 +1,34 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/streambuf.h"
+
+#include "msp/msp.h"
+
+#include "navigation/navigation.h"
+
+// One MSP_WP record without the leading waypoint number
+#define MSP_WP_BATCH_RECORD_SIZE    20
+
+void mspSerializeWaypoint(sbuf_t *dst, const navWaypoint_t *wp);
+void mspDeserializeWaypoint(sbuf_t *src, navWaypoint_t *wp);
+bool mspFcSetWaypoint(uint8_t wpNumber, const navWaypoint_t *wp);
+
+mspResult_e mspFcWaypointBatchOutCommand(sbuf_t *dst, sbuf_t *src);
+mspResult_e mspFcWaypointBatchInCommand(sbuf_t *src, unsigned int dataSize);
@@ -108,7 +108,13 @@ void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs)
     }
 
     if (isRXDataNew) {
-        const timeDelta_t delta = cmpTimeUs(currentTimeUs, previousRcData);
+        // Use the interval between frame arrivals when the RX driver
+        // timestamps them, so the RX task scheduling jitter doesn't
+        // end up in the estimated RC rate.
+        timeDelta_t delta = rxGetFrameTiming()->intervalUs;
+        if (delta <= 0) {
+            delta = cmpTimeUs(currentTimeUs, previousRcData);
+        }
         rcUpdateFrequency = applyRcUpdateFrequencyMedianFilter(1.0f / (delta * 0.000001f));
         previousRcData = currentTimeUs;
 
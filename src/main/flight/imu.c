@@ -158,6 +158,28 @@ STATIC_UNIT_TESTED void imuComputeRotationMatrix(void)
     rMat[2][2] = 1.0f - 2.0f * q1q1 - 2.0f * q2q2;
 }
 
+/*
+ * rMat is kept in sync with orientation, so rotating a vector costs a 3x3 matrix
+ * product instead of the two quaternion products done by quaternionRotateVector()
+ */
+static void imuRotateVectorBodyToEarth(fpVector3_t * result, const fpVector3_t * v)
+{
+    const float x = v->x, y = v->y, z = v->z;
+
+    result->x = rMat[0][0] * x + rMat[0][1] * y + rMat[0][2] * z;
+    result->y = rMat[1][0] * x + rMat[1][1] * y + rMat[1][2] * z;
+    result->z = rMat[2][0] * x + rMat[2][1] * y + rMat[2][2] * z;
+}
+
+static void imuRotateVectorEarthToBody(fpVector3_t * result, const fpVector3_t * v)
+{
+    const float x = v->x, y = v->y, z = v->z;
+
+    result->x = rMat[0][0] * x + rMat[1][0] * y + rMat[2][0] * z;
+    result->y = rMat[0][1] * x + rMat[1][1] * y + rMat[2][1] * z;
+    result->z = rMat[0][2] * x + rMat[1][2] * y + rMat[2][2] * z;
+}
+
 void imuConfigure(void)
 {
     imuRuntimeConfig.dcm_kp_acc = imuConfig()->dcm_kp_acc / 10000.0f;
@@ -215,7 +237,7 @@ void imuSetMagneticDeclination(float declinationDeg)
 void imuTransformVectorBodyToEarth(fpVector3_t * v)
 {
     // From body frame to earth frame
-    quaternionRotateVectorInv(v, v, &orientation);
+    imuRotateVectorBodyToEarth(v, v);
 
     // HACK: This is needed to correctly transform from NED (sensor frame) to NEU (navigation)
     v->y = -v->y;
@@ -227,7 +249,7 @@ void imuTransformVectorEarthToBody(fpVector3_t * v)
     v->y = -v->y;
 
     // From earth frame to body frame
-    quaternionRotateVector(v, v, &orientation);
+    imuRotateVectorEarthToBody(v, v);
 }
 
 #if defined(USE_GPS)
@@ -325,6 +347,8 @@ static void imuCheckAndResetOrientationQuaternion(const fpQuaternion_t * quat, c
     if (feature(FEATURE_BLACKBOX)) {
         blackboxLogEvent(FLIGHT_LOG_EVENT_IMU_FAILURE, (flightLogEventData_t*)&imuErrorEvent);
     }
+#else
+    UNUSED(imuErrorEvent);
 #endif
 }
 
@@ -375,7 +399,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
 
             // (hx; hy; 0) - measured mag field vector in EF (assuming Z-component is zero)
             // This should yield direction to magnetic North (1; 0; 0)
-            quaternionRotateVectorInv(&vMag, magBF, &orientation);    // BF -> EF
+            imuRotateVectorBodyToEarth(&vMag, magBF);    // BF -> EF
 
             // Ignore magnetic inclination
             vMag.z = 0.0f;
@@ -396,7 +420,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
                 vectorCrossProduct(&vMagErr, &vMag, &vCorrectedMagNorth);
 
                 // Rotate error back into body frame
-                quaternionRotateVector(&vMagErr, &vMagErr, &orientation);
+                imuRotateVectorEarthToBody(&vMagErr, &vMagErr);
             }
         }
         if (useCOG) {
@@ -433,7 +457,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
 #endif
             wCoG *= scaleRangef(constrainf((airSpeed+gpsSol.groundSpeed)/2, 400, 1000), 400, 1000, 0.0f, 1.0f);
             // Rotate Forward vector from BF to EF - will yield Heading vector in Earth frame
-            quaternionRotateVectorInv(&vHeadingEF, &vForward, &orientation);
+            imuRotateVectorBodyToEarth(&vHeadingEF, &vForward);
 
             if (STATE(MULTIROTOR)){
                 //when multicopter`s orientation or speed is changing rapidly. less weight on gps heading
@@ -453,7 +477,7 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
                 vectorCrossProduct(&vCoGErr, &vCoG, &vHeadingEF);
 
                 // Rotate error back into body frame
-                quaternionRotateVector(&vCoGErr, &vCoGErr, &orientation);
+                imuRotateVectorEarthToBody(&vCoGErr, &vCoGErr);
             }
         }
         fpVector3_t vErr = { .v = { 0.0f, 0.0f, 0.0f } };
@@ -480,11 +504,12 @@ static void imuMahonyAHRSupdate(float dt, const fpVector3_t * gyroBF, const fpVe
 
     /* Step 2: Roll and pitch correction -  use measured acceleration vector */
     if (accBF) {
-        static const fpVector3_t vGravity = { .v = { 0.0f, 0.0f, 1.0f } };
         fpVector3_t vEstGravity, vAcc, vErr;
 
-        // Calculate estimated gravity vector in body frame
-        quaternionRotateVector(&vEstGravity, &vGravity, &orientation);    // EF -> BF
+        // Calculate estimated gravity vector in body frame. EF -> BF rotation of (0, 0, 1) is the last row of rMat
+        vEstGravity.x = rMat[2][0];
+        vEstGravity.y = rMat[2][1];
+        vEstGravity.z = rMat[2][2];
 
         // Error is sum of cross product between estimated direction and measured direction of gravity
         vectorNormalize(&vAcc, accBF);
@@ -665,7 +690,7 @@ static void imuCalculateGPSacceleration(fpVector3_t *vEstcentrifugalAccelBF, flo
         vGPSacc.y = (currentGPSvel.y - lastGPSvel.y) / (MS2S(time_delta_ms));
         vGPSacc.z = (currentGPSvel.z - lastGPSvel.z) / (MS2S(time_delta_ms));
         // Calculate estimated centrifugal accleration vector in body frame
-        quaternionRotateVector(vEstcentrifugalAccelBF, &vGPSacc, &orientation); // EF -> BF
+        imuRotateVectorEarthToBody(vEstcentrifugalAccelBF, &vGPSacc); // EF -> BF
         lastGPSNewDataTime = currenttime;
         lastGPSvel = currentGPSvel;
     }
@@ -727,6 +752,7 @@ void imuUpdateTailSitter(void)
     if (((bool)STATE(TAILSITTER)) != lastTailSitter){
         fpQuaternion_t* rotation_for_tailsitter= getTailSitterQuaternion(STATE(TAILSITTER));
         quaternionMultiply(&orientation, &orientation, rotation_for_tailsitter);
+        imuComputeRotationMatrix();
     }
     lastTailSitter = STATE(TAILSITTER);
 }
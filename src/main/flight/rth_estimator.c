@@ -1,9 +1,12 @@
 
 #include "build/debug.h"
 
+#include "common/axis.h"
 #include "common/maths.h"
 #include "common/utils.h"
 
+#include "drivers/time.h"
+
 #include "fc/config.h"
 #include "fc/fc_core.h"
 #include "fc/runtime_config.h"
@@ -17,6 +20,7 @@
 #include "sensors/battery.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #if defined(USE_ADC) && defined(USE_GPS)
 
@@ -144,7 +148,7 @@ static float estimateRTHEnergyAfterInitialClimb(float distanceToHome, float spee
 }
 
 // returns Wh
-static float calculateRemainingEnergyBeforeRTH(bool takeWindIntoAccount) {
+static float computeRTHEnergyToHome(bool takeWindIntoAccount) {
 
     const float RTH_initial_altitude_change = MAX(0, (getFinalRTHAltitude() - getEstimatedActualPosition(Z)) / 100);
 
@@ -178,8 +182,69 @@ static float calculateRemainingEnergyBeforeRTH(bool takeWindIntoAccount) {
 #else
     const float energy_to_home = estimateRTHInitialAltitudeChangeEnergy(RTH_initial_altitude_change, 0) + estimateRTHEnergyAfterInitialClimb(RTH_distance, RTH_speed); // Wh
 #endif
+    return energy_to_home;
+}
+
+// The energy needed to get home is cached per wind compensation flag and recomputed once a second, or
+// sooner when the route home changed by more than the estimate is sensitive to. Remaining battery
+// energy is read live, only the geometry is quantized.
+#define RTH_ESTIMATOR_CACHE_TIMEOUT_MS  1000
+
+typedef struct {
+    int16_t altitude;               // m
+    uint16_t distanceToHome;        // 10 m
+    int16_t directionToHome;        // 5 deg
+    int16_t yaw;                    // 5 deg
+    int16_t wind[XYZ_AXIS_COUNT];   // m/s
+} rthEstimatorInputs_t;
+
+typedef struct {
+    rthEstimatorInputs_t inputs;
+    timeMs_t updatedAt;
+    float energyToHome;
+    bool valid;
+} rthEstimatorCache_t;
+
+static rthEstimatorCache_t rthEstimatorCache[2];
+
+static void snapshotRTHEstimatorInputs(rthEstimatorInputs_t *inputs, bool takeWindIntoAccount) {
+    memset(inputs, 0, sizeof(*inputs));
+    inputs->altitude = lrintf(getEstimatedActualPosition(Z) / 100);
+    inputs->distanceToHome = MIN(GPS_distanceToHome / 10, (uint32_t)UINT16_MAX);
+    inputs->directionToHome = GPS_directionToHome / 5;
+    inputs->yaw = attitude.values.yaw / 50;
+#ifdef USE_WIND_ESTIMATOR
+    if (takeWindIntoAccount) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            inputs->wind[axis] = lrintf(getEstimatedWindSpeed(axis) / 100);
+        }
+    }
+#else
+    UNUSED(takeWindIntoAccount);
+#endif
+}
+
+// returns Wh
+static float calculateRemainingEnergyBeforeRTH(bool takeWindIntoAccount) {
+    rthEstimatorCache_t *cache = &rthEstimatorCache[takeWindIntoAccount ? 1 : 0];
+    const timeMs_t currentTimeMs = millis();
+    rthEstimatorInputs_t inputs;
+
+    snapshotRTHEstimatorInputs(&inputs, takeWindIntoAccount);
+
+    if (!cache->valid || memcmp(&inputs, &cache->inputs, sizeof(inputs)) || (currentTimeMs - cache->updatedAt) >= RTH_ESTIMATOR_CACHE_TIMEOUT_MS) {
+        cache->energyToHome = computeRTHEnergyToHome(takeWindIntoAccount);
+        cache->inputs = inputs;
+        cache->updatedAt = currentTimeMs;
+        cache->valid = true;
+    }
+
+    // error: return error code directly
+    if (cache->energyToHome < 0)
+        return cache->energyToHome;
+
     const float energy_margin_abs = (currentBatteryProfile->capacity.value - currentBatteryProfile->capacity.critical) * batteryMetersConfig()->rth_energy_margin / 100000; // Wh
-    const float remaining_energy_before_rth = getBatteryRemainingCapacity() / 1000 - energy_margin_abs - energy_to_home; // Wh
+    const float remaining_energy_before_rth = getBatteryRemainingCapacity() / 1000 - energy_margin_abs - cache->energyToHome; // Wh
 
     if (remaining_energy_before_rth < 0) // No energy left = No time left
         return 0;
@@ -42,19 +42,40 @@
 
 #include "io/gps.h"
 
-
-#define WINDESTIMATOR_TIMEOUT       60*15 // 15min with out altitude change
-#define WINDESTIMATOR_ALTITUDE_SCALE WINDESTIMATOR_TIMEOUT/500.0f //or 500m altitude change
-// Based on WindEstimation.pdf paper
+#include "sensors/pitotmeter.h"
+#include "sensors/sensors.h"
+
+
+// Wind and airspeed are estimated together by a recursive least-squares fit of
+//   groundVelocity = wind + airspeed * fuselageDirection
+// over all GPS samples. Every heading change makes the fit better conditioned, no need to wait for a turn
+// and throw away everything measured in between.
+#define WINDESTIMATOR_STATE_COUNT       4       // wind X, Y, Z and airspeed along the fuselage
+#define WINDESTIMATOR_AIRSPEED          3
+#define WINDESTIMATOR_INITIAL_VARIANCE  sq(2000.0f) // (cm/s)^2
+#define WINDESTIMATOR_GPS_VARIANCE      sq(100.0f)  // GPS velocity and attitude error, (cm/s)^2
+#define WINDESTIMATOR_PITOT_VARIANCE    sq(150.0f)  // (cm/s)^2
+#define WINDESTIMATOR_WIND_DRIFT        sq(3.0f)    // Wind change over time, (cm/s)^2 per second
+#define WINDESTIMATOR_AIRSPEED_DRIFT    sq(30.0f)   // Airspeed change over time, (cm/s)^2 per second
+#define WINDESTIMATOR_ALTITUDE_DRIFT    1.0f        // Wind change over altitude, cm/s per m
+#define WINDESTIMATOR_VALID_VARIANCE    sq(100.0f)  // Wind estimate is usable below this uncertainty, (cm/s)^2
+#define WINDESTIMATOR_GATE              25.0f       // Reject GPS samples further than 5 sigma away once converged
+#define WINDESTIMATOR_MAX_REJECTS       10          // Consecutive gated updates before the fit is assumed stale
+#define WINDESTIMATOR_RESET_TIMEOUT     (10 * USECS_PER_SEC)
+#define WINDESTIMATOR_MAX_AGE           (15 * 60 * USECS_PER_SEC)   // Never trust an estimate without updates for longer
 
 static bool hasValidWindEstimate = false;
+static timeUs_t windEstimateValidUntilUs;
 static float estimatedWind[XYZ_AXIS_COUNT] = {0, 0, 0};    // wind velocity vectors in cm / sec in earth frame
-static float lastGroundVelocity[XYZ_AXIS_COUNT];
-static float lastFuselageDirection[XYZ_AXIS_COUNT];
+
+static float windState[WINDESTIMATOR_STATE_COUNT];
+static float windCovariance[WINDESTIMATOR_STATE_COUNT][WINDESTIMATOR_STATE_COUNT];
+static uint8_t windRejectedUpdates;
 
 bool isEstimatedWindSpeedValid(void)
 {
-    return hasValidWindEstimate 
+    // Without updates the uncertainty keeps growing, the estimate expires once it would no longer be converged
+    return (hasValidWindEstimate && cmpTimeUs(micros(), windEstimateValidUntilUs) < 0)
 #ifdef USE_GPS_FIX_ESTIMATION
         || STATE(GPS_ESTIMATED_FIX)  //use any wind estimate with GPS fix estimation.
 #endif
@@ -82,17 +103,90 @@ float getEstimatedHorizontalWindSpeed(uint16_t *angle)
     return calc_length_pythagorean_2D(xWindSpeed, yWindSpeed);
 }
 
+// Keep the current state but forget how certain it is, so the next samples can pull it to a new wind
+static void windEstimatorInflateCovariance(void)
+{
+    memset(windCovariance, 0, sizeof(windCovariance));
+    for (int i = 0; i < WINDESTIMATOR_STATE_COUNT; i++) {
+        windCovariance[i][i] = WINDESTIMATOR_INITIAL_VARIANCE;
+    }
+}
+
+static void windEstimatorReset(const float groundVelocity[XYZ_AXIS_COUNT])
+{
+    windEstimatorInflateCovariance();
+    windRejectedUpdates = 0;
+
+    // Start from "no wind", all ground speed is airspeed
+    windState[X] = 0;
+    windState[Y] = 0;
+    windState[Z] = 0;
+    windState[WINDESTIMATOR_AIRSPEED] = calc_length_pythagorean_3D(groundVelocity[X], groundVelocity[Y], groundVelocity[Z]);
+}
+
+static void windEstimatorAddDrift(float dT, float altitudeChange)
+{
+    const float windDrift = WINDESTIMATOR_WIND_DRIFT * dT + sq(WINDESTIMATOR_ALTITUDE_DRIFT * altitudeChange);
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        windCovariance[i][i] = MIN(windCovariance[i][i] + windDrift, WINDESTIMATOR_INITIAL_VARIANCE);
+    }
+    windCovariance[WINDESTIMATOR_AIRSPEED][WINDESTIMATOR_AIRSPEED] = MIN(windCovariance[WINDESTIMATOR_AIRSPEED][WINDESTIMATOR_AIRSPEED] + WINDESTIMATOR_AIRSPEED_DRIFT * dT, WINDESTIMATOR_INITIAL_VARIANCE);
+}
+
+/*
+ * Fuse one scalar measurement y = h * state with the given variance.
+ * Returns false if the sample was rejected as an outlier.
+ */
+static bool windEstimatorFuse(const float h[WINDESTIMATOR_STATE_COUNT], float y, float variance, bool gate)
+{
+    float ph[WINDESTIMATOR_STATE_COUNT];
+    float innovation = y;
+    float innovationVariance = variance;
+
+    for (int i = 0; i < WINDESTIMATOR_STATE_COUNT; i++) {
+        ph[i] = 0;
+        for (int j = 0; j < WINDESTIMATOR_STATE_COUNT; j++) {
+            ph[i] += windCovariance[i][j] * h[j];
+        }
+        innovation -= h[i] * windState[i];
+        innovationVariance += h[i] * ph[i];
+    }
+
+    if (gate && sq(innovation) > WINDESTIMATOR_GATE * innovationVariance) {
+        return false;
+    }
+
+    const float invInnovationVariance = 1.0f / innovationVariance;
+    for (int i = 0; i < WINDESTIMATOR_STATE_COUNT; i++) {
+        const float gain = ph[i] * invInnovationVariance;
+        windState[i] += gain * innovation;
+        for (int j = 0; j < WINDESTIMATOR_STATE_COUNT; j++) {
+            windCovariance[i][j] -= gain * ph[j];
+        }
+    }
+
+    return true;
+}
+
+static bool windEstimatorIsConverged(void)
+{
+    return windCovariance[X][X] < WINDESTIMATOR_VALID_VARIANCE && windCovariance[Y][Y] < WINDESTIMATOR_VALID_VARIANCE;
+}
+
+// Time until drift alone pushes the horizontal wind uncertainty past the valid threshold
+static timeDelta_t windEstimatorValidTime(void)
+{
+    const float margin = WINDESTIMATOR_VALID_VARIANCE - MAX(windCovariance[X][X], windCovariance[Y][Y]);
+    return MIN(margin / WINDESTIMATOR_WIND_DRIFT, US2S(WINDESTIMATOR_MAX_AGE)) * USECS_PER_SEC;
+}
+
 void updateWindEstimator(timeUs_t currentTimeUs)
 {
     static timeUs_t lastUpdateUs = 0;
-    static timeUs_t lastValidWindEstimate = 0;
-    static float lastValidEstimateAltitude = 0.0f;
+    static float lastAltitude = 0.0f;
     float currentAltitude = gpsSol.llh.alt / 100.0f; // altitude in m
 
-    if ((US2S(currentTimeUs - lastValidWindEstimate) + WINDESTIMATOR_ALTITUDE_SCALE * fabsf(currentAltitude - lastValidEstimateAltitude)) > WINDESTIMATOR_TIMEOUT) {
-        hasValidWindEstimate = false;
-    }
-
     if (!STATE(FIXED_WING_LEGACY) ||
         !isGPSHeadingValid() ||
         !gpsSol.flags.validVelNE ||
@@ -105,12 +199,7 @@ void updateWindEstimator(timeUs_t currentTimeUs)
     }
 
     float groundVelocity[XYZ_AXIS_COUNT];
-    float groundVelocityDiff[XYZ_AXIS_COUNT];
-    float groundVelocitySum[XYZ_AXIS_COUNT];
-
     float fuselageDirection[XYZ_AXIS_COUNT];
-    float fuselageDirectionDiff[XYZ_AXIS_COUNT];
-    float fuselageDirectionSum[XYZ_AXIS_COUNT];
 
     // Get current 3D velocity from GPS in cm/s
     // relative to earth frame
@@ -123,73 +212,68 @@ void updateWindEstimator(timeUs_t currentTimeUs)
     fuselageDirection[Y] = -HeadVecEFFiltered.y;
     fuselageDirection[Z] = -HeadVecEFFiltered.z;
 
-    timeDelta_t timeDelta = cmpTimeUs(currentTimeUs, lastUpdateUs);
-    // scrap our data and start over if we're taking too long to get a direction change
-    if (lastUpdateUs == 0 || timeDelta > 10 * USECS_PER_SEC) {
+    const timeDelta_t timeDelta = cmpTimeUs(currentTimeUs, lastUpdateUs);
+    const bool firstUpdate = lastUpdateUs == 0;
+    lastUpdateUs = currentTimeUs;
 
-        lastUpdateUs = currentTimeUs;
+    if (timeDelta <= 0 && !firstUpdate) {
+        return;
+    }
+
+    // Account for the wind change over any gap in samples. If that leaves nothing
+    // usable of the old fit, or there never was one, start over from this sample.
+    if (!firstUpdate) {
+        windEstimatorAddDrift(US2S(timeDelta), currentAltitude - lastAltitude);
+    }
+    lastAltitude = currentAltitude;
 
-        memcpy(lastFuselageDirection, fuselageDirection, sizeof(lastFuselageDirection));
-        memcpy(lastGroundVelocity, groundVelocity, sizeof(lastGroundVelocity));
+    if (firstUpdate || (timeDelta > WINDESTIMATOR_RESET_TIMEOUT && !windEstimatorIsConverged())) {
+        windEstimatorReset(groundVelocity);
+        hasValidWindEstimate = false;
         return;
     }
 
-    fuselageDirectionDiff[X] = fuselageDirection[X] - lastFuselageDirection[X];
-    fuselageDirectionDiff[Y] = fuselageDirection[Y] - lastFuselageDirection[Y];
-    fuselageDirectionDiff[Z] = fuselageDirection[Z] - lastFuselageDirection[Z];
-
-    float diffLengthSq = sq(fuselageDirectionDiff[X]) + sq(fuselageDirectionDiff[Y]) + sq(fuselageDirectionDiff[Z]);
-    
-    // Very small changes in attitude will result in a denominator
-    // very close to zero which will introduce too much error in the
-    // estimation.
-    //
-    // TODO: Is 0.2f an adequate threshold?
-    if (diffLengthSq > sq(0.2f)) {
-        // when turning, use the attitude response to estimate wind speed
-        groundVelocityDiff[X] = groundVelocity[X] - lastGroundVelocity[X];
-        groundVelocityDiff[Y] = groundVelocity[Y] - lastGroundVelocity[Y];
-        groundVelocityDiff[Z] = groundVelocity[Z] - lastGroundVelocity[Z];
-
-        // estimate airspeed it using equation 6
-        float V = (calc_length_pythagorean_3D(groundVelocityDiff[X], groundVelocityDiff[Y], groundVelocityDiff[Z])) / fast_fsqrtf(diffLengthSq);
-
-        fuselageDirectionSum[X] = fuselageDirection[X] + lastFuselageDirection[X];
-        fuselageDirectionSum[Y] = fuselageDirection[Y] + lastFuselageDirection[Y];
-        fuselageDirectionSum[Z] = fuselageDirection[Z] + lastFuselageDirection[Z];
-
-        groundVelocitySum[X] = groundVelocity[X] + lastGroundVelocity[X];
-        groundVelocitySum[Y] = groundVelocity[Y] + lastGroundVelocity[Y];
-        groundVelocitySum[Z] = groundVelocity[Z] + lastGroundVelocity[Z];
-
-        memcpy(lastFuselageDirection, fuselageDirection, sizeof(lastFuselageDirection));
-        memcpy(lastGroundVelocity, groundVelocity, sizeof(lastGroundVelocity));
-
-        float theta = atan2f(groundVelocityDiff[Y], groundVelocityDiff[X]) - atan2f(fuselageDirectionDiff[Y], fuselageDirectionDiff[X]);// equation 9
-        float sintheta = sinf(theta);
-        float costheta = cosf(theta);
-
-        float wind[XYZ_AXIS_COUNT];
-        wind[X] = (groundVelocitySum[X] - V * (costheta * fuselageDirectionSum[X] - sintheta * fuselageDirectionSum[Y])) * 0.5f;// equation 10
-        wind[Y] = (groundVelocitySum[Y] - V * (sintheta * fuselageDirectionSum[X] + costheta * fuselageDirectionSum[Y])) * 0.5f;// equation 11
-        wind[Z] = (groundVelocitySum[Z] - V * fuselageDirectionSum[Z]) * 0.5f;// equation 12
-
-        float prevWindLength = calc_length_pythagorean_3D(estimatedWind[X], estimatedWind[Y], estimatedWind[Z]);
-        float windLength = calc_length_pythagorean_3D(wind[X], wind[Y], wind[Z]);
-
-        //is this really needed? The reason it is here might be above equation was wrong in early implementations
-        if (windLength < prevWindLength + 4000) {
-            // TODO: Better filtering
-            estimatedWind[X] = estimatedWind[X] * 0.98f + wind[X] * 0.02f;
-            estimatedWind[Y] = estimatedWind[Y] * 0.98f + wind[Y] * 0.02f;
-            estimatedWind[Z] = estimatedWind[Z] * 0.98f + wind[Z] * 0.02f;
-        }
+    const bool gate = windEstimatorIsConverged();
+    bool rejected = false;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        float h[WINDESTIMATOR_STATE_COUNT] = { 0 };
+        h[axis] = 1.0f;
+        h[WINDESTIMATOR_AIRSPEED] = fuselageDirection[axis];
+        rejected |= !windEstimatorFuse(h, groundVelocity[axis], WINDESTIMATOR_GPS_VARIANCE, gate);
+    }
 
-        lastUpdateUs = currentTimeUs;
-        lastValidWindEstimate = currentTimeUs;
-        hasValidWindEstimate = true;
-        lastValidEstimateAltitude = currentAltitude;
+#ifdef USE_PITOT
+    // A real airspeed sensor observes the airspeed directly, virtual pitot is derived from this estimate
+    if (sensors(SENSOR_PITOT) && detectedSensors[SENSOR_INDEX_PITOT] != PITOT_VIRTUAL && pitotIsHealthy()) {
+        const float h[WINDESTIMATOR_STATE_COUNT] = { 0, 0, 0, 1.0f };
+        windEstimatorFuse(h, getAirspeedEstimate(), WINDESTIMATOR_PITOT_VARIANCE, gate);
     }
+#endif
+
+    // A converged fit rejects a sudden wind change as an outlier and would keep doing so until drift
+    // catches up. If GPS keeps disagreeing, stop vouching for the old estimate and let the fit move.
+    windRejectedUpdates = rejected ? windRejectedUpdates + 1 : 0;
+    if (windRejectedUpdates >= WINDESTIMATOR_MAX_REJECTS) {
+        windEstimatorInflateCovariance();
+        windRejectedUpdates = 0;
+    }
+
+    hasValidWindEstimate = windEstimatorIsConverged();
+    if (hasValidWindEstimate && !rejected) {
+        windEstimateValidUntilUs = currentTimeUs + windEstimatorValidTime();
+        estimatedWind[X] = windState[X];
+        estimatedWind[Y] = windState[Y];
+        estimatedWind[Z] = windState[Z];
+    }
+
+    DEBUG_SET(DEBUG_WIND, 0, lrintf(windState[X]));
+    DEBUG_SET(DEBUG_WIND, 1, lrintf(windState[Y]));
+    DEBUG_SET(DEBUG_WIND, 2, lrintf(windState[Z]));
+    DEBUG_SET(DEBUG_WIND, 3, lrintf(windState[WINDESTIMATOR_AIRSPEED]));
+    DEBUG_SET(DEBUG_WIND, 4, lrintf(fast_fsqrtf(windCovariance[X][X])));
+    DEBUG_SET(DEBUG_WIND, 5, lrintf(fast_fsqrtf(windCovariance[Y][Y])));
+    DEBUG_SET(DEBUG_WIND, 6, lrintf(fast_fsqrtf(windCovariance[Z][Z])));
+    DEBUG_SET(DEBUG_WIND, 7, lrintf(fast_fsqrtf(windCovariance[WINDESTIMATOR_AIRSPEED][WINDESTIMATOR_AIRSPEED])));
 }
 
 #endif
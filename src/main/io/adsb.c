@@ -25,6 +25,7 @@
 #include "navigation/navigation_private.h"
 
 #include "common/maths.h"
+#include "common/utils.h"
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
 #include "common/mavlink.h"
@@ -36,21 +37,134 @@
 
 #ifdef USE_ADSB
 
+// Vehicles are looked up by ICAO through a chained hash, slots not in use are kept on a free stack
+#define ADSB_HASH_BUCKETS   (MAX_ADSB_VEHICLES * 2)
+#define ADSB_SLOT_NONE      0xFF
+
+STATIC_ASSERT(MAX_ADSB_VEHICLES < ADSB_SLOT_NONE, MAX_ADSB_VEHICLES_exceeded_allowable_range);
+
 adsbVehicle_t adsbVehiclesList[MAX_ADSB_VEHICLES];
 adsbVehicleStatus_t adsbVehiclesStatus;
 
 adsbVehicleValues_t vehicleValues;
 
+static uint8_t adsbHashHead[ADSB_HASH_BUCKETS];
+static uint8_t adsbHashNext[MAX_ADSB_VEHICLES];
+static uint8_t adsbFreeSlots[MAX_ADSB_VEHICLES];
+static uint8_t adsbFreeSlotsCount;
+static uint8_t adsbActiveVehiclesCount;
+
+// Closest vehicle is tracked as vehicles are updated, full scan only when it moved away or expired
+static adsbVehicle_t *adsbClosestVehicle;
+static uint32_t adsbClosestVehicleDist;
+static bool adsbClosestVehicleDirty;
+
+static void adsbSetClosestVehicle(adsbVehicle_t *vehicle)
+{
+    adsbClosestVehicle = vehicle;
+    adsbClosestVehicleDist = vehicle ? vehicle->calculatedVehicleValues.dist : 0;
+}
+
+void adsbInit(void)
+{
+    memset(adsbHashHead, ADSB_SLOT_NONE, sizeof(adsbHashHead));
+    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
+        adsbHashNext[i] = ADSB_SLOT_NONE;
+        adsbFreeSlots[i] = MAX_ADSB_VEHICLES - 1 - i;
+    }
+    adsbFreeSlotsCount = MAX_ADSB_VEHICLES;
+    adsbActiveVehiclesCount = 0;
+    adsbSetClosestVehicle(NULL);
+    adsbClosestVehicleDirty = false;
+}
+
+static uint8_t adsbHashBucket(uint32_t icao)
+{
+    // ICAO addresses are allocated in country blocks, mix the bits before taking the modulo
+    icao ^= icao >> 12;
+    icao *= 0x9E3779B1;
+    return (icao >> 16) % ADSB_HASH_BUCKETS;
+}
+
+static uint8_t adsbSlot(const adsbVehicle_t *vehicle)
+{
+    return vehicle - adsbVehiclesList;
+}
+
+static void adsbHashInsert(adsbVehicle_t *vehicle)
+{
+    const uint8_t bucket = adsbHashBucket(vehicle->vehicleValues.icao);
+    const uint8_t slot = adsbSlot(vehicle);
+
+    adsbHashNext[slot] = adsbHashHead[bucket];
+    adsbHashHead[bucket] = slot;
+}
+
+static void adsbHashRemove(adsbVehicle_t *vehicle)
+{
+    const uint8_t slot = adsbSlot(vehicle);
+    uint8_t *link = &adsbHashHead[adsbHashBucket(vehicle->vehicleValues.icao)];
+
+    while (*link != ADSB_SLOT_NONE) {
+        if (*link == slot) {
+            *link = adsbHashNext[slot];
+            adsbHashNext[slot] = ADSB_SLOT_NONE;
+            return;
+        }
+        link = &adsbHashNext[*link];
+    }
+}
+
+static void adsbRemoveVehicle(adsbVehicle_t *vehicle)
+{
+    if (vehicle->ttl == 0) {
+        return;
+    }
+
+    adsbHashRemove(vehicle);
+    vehicle->ttl = 0;
+    vehicle->calculatedVehicleValues.valid = false;
+    adsbFreeSlots[adsbFreeSlotsCount++] = adsbSlot(vehicle);
+    adsbActiveVehiclesCount--;
+
+    if (vehicle == adsbClosestVehicle) {
+        adsbSetClosestVehicle(NULL);
+        adsbClosestVehicleDirty = true;
+    }
+}
+
+static void adsbUpdateClosestVehicle(adsbVehicle_t *vehicle)
+{
+    if (!vehicle->calculatedVehicleValues.valid) {
+        if (vehicle == adsbClosestVehicle) {
+            adsbSetClosestVehicle(NULL);
+            adsbClosestVehicleDirty = true;
+        }
+        return;
+    }
+
+    if (vehicle == adsbClosestVehicle) {
+        if (vehicle->calculatedVehicleValues.dist <= adsbClosestVehicleDist) {
+            adsbClosestVehicleDist = vehicle->calculatedVehicleValues.dist;
+        } else {
+            // Closest one moved away, another vehicle might be closer now
+            adsbClosestVehicleDirty = true;
+        }
+    } else if (adsbClosestVehicle == NULL && !adsbClosestVehicleDirty) {
+        adsbSetClosestVehicle(vehicle);
+    } else if (adsbClosestVehicle != NULL && vehicle->calculatedVehicleValues.dist < adsbClosestVehicleDist) {
+        adsbSetClosestVehicle(vehicle);
+    }
+}
 
 adsbVehicleValues_t* getVehicleForFill(void){
     return &vehicleValues;
 }
 
-// use bsearch function
 adsbVehicle_t *findVehicleByIcao(uint32_t avicao) {
-    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-        if (avicao == adsbVehiclesList[i].vehicleValues.icao) {
-            return &adsbVehiclesList[i];
+    for (uint8_t slot = adsbHashHead[adsbHashBucket(avicao)]; slot != ADSB_SLOT_NONE; slot = adsbHashNext[slot]) {
+        if (avicao == adsbVehiclesList[slot].vehicleValues.icao) {
+            return &adsbVehiclesList[slot];
         }
     }
     return NULL;
@@ -67,40 +181,73 @@ adsbVehicle_t *findVehicleFarthest(void) {
 }
 
 uint8_t getActiveVehiclesCount(void) {
-    uint8_t total = 0;
-    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-        if (adsbVehiclesList[i].ttl > 0) {
-            total++;
+    return adsbActiveVehiclesCount;
+}
+
+adsbVehicle_t *findVehicleClosest(void) {
+    if (adsbClosestVehicleDirty) {
+        adsbVehicle_t *adsbLocal = NULL;
+        for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
+            if (adsbVehiclesList[i].ttl > 0 && adsbVehiclesList[i].calculatedVehicleValues.valid && (adsbLocal == NULL || adsbLocal->calculatedVehicleValues.dist > adsbVehiclesList[i].calculatedVehicleValues.dist)) {
+                adsbLocal = &adsbVehiclesList[i];
+            }
         }
+        adsbSetClosestVehicle(adsbLocal);
+        adsbClosestVehicleDirty = false;
     }
-    return total;
+
+    return adsbClosestVehicle;
 }
 
-adsbVehicle_t *findVehicleClosest(void) {
-    adsbVehicle_t *adsbLocal = NULL;
-    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-        if (adsbVehiclesList[i].ttl > 0 && adsbVehiclesList[i].calculatedVehicleValues.valid && (adsbLocal == NULL || adsbLocal->calculatedVehicleValues.dist > adsbVehiclesList[i].calculatedVehicleValues.dist)) {
-            adsbLocal = &adsbVehiclesList[i];
+/*
+ * Fill vehicles[] with up to maxCount active vehicles, the ones with known distance first ordered
+ * from the closest, followed by the ones received without a GPS fix. Returns the number of vehicles stored.
+ */
+uint8_t findVehiclesClosest(adsbVehicle_t **vehicles, uint8_t maxCount) {
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES && maxCount > 0; i++) {
+        adsbVehicle_t *vehicle = &adsbVehiclesList[i];
+
+        if (vehicle->ttl == 0 || !vehicle->calculatedVehicleValues.valid) {
+            continue;
+        }
+
+        if (count == maxCount && vehicle->calculatedVehicleValues.dist >= vehicles[count - 1]->calculatedVehicleValues.dist) {
+            continue;
         }
+
+        // Insertion into the sorted list, dropping the farthest one when full
+        uint8_t pos = (count < maxCount) ? count++ : count - 1;
+        while (pos > 0 && vehicles[pos - 1]->calculatedVehicleValues.dist > vehicle->calculatedVehicleValues.dist) {
+            vehicles[pos] = vehicles[pos - 1];
+            pos--;
+        }
+        vehicles[pos] = vehicle;
     }
-    return adsbLocal;
+
+    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES && count < maxCount; i++) {
+        if (adsbVehiclesList[i].ttl > 0 && !adsbVehiclesList[i].calculatedVehicleValues.valid) {
+            vehicles[count++] = &adsbVehiclesList[i];
+        }
+    }
+
+    return count;
 }
 
 adsbVehicle_t *findFreeSpaceInList(void) {
-    //find expired first
-    for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-        if (adsbVehiclesList[i].ttl == 0) {
-            return &adsbVehiclesList[i];
-        }
+    if (adsbFreeSlotsCount == 0) {
+        return NULL;
     }
 
-    return NULL;
+    adsbVehicle_t *vehicle = &adsbVehiclesList[adsbFreeSlots[--adsbFreeSlotsCount]];
+    adsbActiveVehiclesCount++;
+    return vehicle;
 }
 
 adsbVehicle_t *findVehicleNotCalculated(void) {
-    //find expired first
     for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-        if (adsbVehiclesList[i].calculatedVehicleValues.valid == false) {
+        if (adsbVehiclesList[i].ttl > 0 && adsbVehiclesList[i].calculatedVehicleValues.valid == false) {
             return &adsbVehiclesList[i];
         }
     }
@@ -136,6 +283,22 @@ bool adsbHeartbeat(void){
     return true;
 }
 
+static void adsbStoreVehicle(adsbVehicle_t *vehicle, const adsbVehicleValues_t* vehicleValuesLocal) {
+    const bool rehash = vehicle->ttl == 0 || vehicle->vehicleValues.icao != vehicleValuesLocal->icao;
+
+    if (rehash) {
+        if (vehicle->ttl > 0) {
+            adsbHashRemove(vehicle);
+        }
+        memcpy(&(vehicle->vehicleValues), vehicleValuesLocal, sizeof(vehicle->vehicleValues));
+        adsbHashInsert(vehicle);
+    } else {
+        memcpy(&(vehicle->vehicleValues), vehicleValuesLocal, sizeof(vehicle->vehicleValues));
+    }
+
+    vehicle->ttl = ADSB_MAX_SECONDS_KEEP_INACTIVE_PLANE_IN_LIST;
+}
+
 void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal) {
 
     // no valid lat lon or altitude
@@ -149,7 +312,7 @@ void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal) {
 
     vehicle = findVehicleByIcao(vehicleValuesLocal->icao);
     if(vehicle != NULL && vehicleValuesLocal->tslc > ADSB_MAX_SECONDS_KEEP_INACTIVE_PLANE_IN_LIST){
-        vehicle->ttl = 0;
+        adsbRemoveVehicle(vehicle);
         return;
     }
 
@@ -161,15 +324,14 @@ void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal) {
         }
 
         if (vehicle != NULL) {
-            memcpy(&(vehicle->vehicleValues), vehicleValuesLocal, sizeof(vehicle->vehicleValues));
-            vehicle->ttl = ADSB_MAX_SECONDS_KEEP_INACTIVE_PLANE_IN_LIST;
+            adsbStoreVehicle(vehicle, vehicleValuesLocal);
             vehicle->calculatedVehicleValues.valid = false;
+            adsbUpdateClosestVehicle(vehicle);
             return;
         }
     } else {
         // GPS mode, GPS is fixed and has enough sats
 
-
         if(vehicle == NULL){
             vehicle = findFreeSpaceInList();
         }
@@ -179,13 +341,20 @@ void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal) {
         }
 
         if(vehicle == NULL){
-            vehicle = findVehicleFarthest();
+            // List is full of located vehicles, only replace the farthest one by a closer one
+            adsbVehicle_t *farthest = findVehicleFarthest();
+            uint32_t dist;
+            int32_t dir;
+
+            gpsDistanceCmBearing(gpsSol.llh.lat, gpsSol.llh.lon, vehicleValuesLocal->lat, vehicleValuesLocal->lon, &dist, &dir);
+            if (farthest != NULL && dist < farthest->calculatedVehicleValues.dist) {
+                vehicle = farthest;
+            }
         }
 
         if (vehicle != NULL) {
-            memcpy(&(vehicle->vehicleValues), vehicleValuesLocal, sizeof(vehicle->vehicleValues));
+            adsbStoreVehicle(vehicle, vehicleValuesLocal);
             recalculateVehicle(vehicle);
-            vehicle->ttl = ADSB_MAX_SECONDS_KEEP_INACTIVE_PLANE_IN_LIST;
             return;
         }
     }
@@ -194,13 +363,14 @@ void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal) {
 void recalculateVehicle(adsbVehicle_t* vehicle){
     gpsDistanceCmBearing(gpsSol.llh.lat, gpsSol.llh.lon, vehicle->vehicleValues.lat, vehicle->vehicleValues.lon, &(vehicle->calculatedVehicleValues.dist), &(vehicle->calculatedVehicleValues.dir));
 
-    if (vehicle != NULL && vehicle->calculatedVehicleValues.dist > ADSB_LIMIT_CM) {
-        vehicle->ttl = 0;
+    if (vehicle->calculatedVehicleValues.dist > ADSB_LIMIT_CM) {
+        adsbRemoveVehicle(vehicle);
         return;
     }
 
     vehicle->calculatedVehicleValues.verticalDistance = vehicle->vehicleValues.alt - (int32_t)getEstimatedActualPosition(Z) - GPS_home.alt;
     vehicle->calculatedVehicleValues.valid = true;
+    adsbUpdateClosestVehicle(vehicle);
 }
 
 void adsbTtlClean(timeUs_t currentTimeUs) {
@@ -212,7 +382,9 @@ void adsbTtlClean(timeUs_t currentTimeUs) {
     if (adsbTtlSinceLastCleanServiced > 1000000) // 1s
     {
         for (uint8_t i = 0; i < MAX_ADSB_VEHICLES; i++) {
-            if (adsbVehiclesList[i].ttl > 0) {
+            if (adsbVehiclesList[i].ttl == 1) {
+                adsbRemoveVehicle(&adsbVehiclesList[i]);
+            } else if (adsbVehiclesList[i].ttl > 0) {
                 adsbVehiclesList[i].ttl--;
             }
         }
@@ -226,4 +398,3 @@ bool enviromentOkForCalculatingDistaceBearing(void){
 }
 
 #endif
-
@@ -57,10 +57,11 @@ typedef struct {
    uint32_t heartbeatMessagesTotal;
 } adsbVehicleStatus_t;
 
+void adsbInit(void);
 void adsbNewVehicle(adsbVehicleValues_t* vehicleValuesLocal);
 bool adsbHeartbeat(void);
 adsbVehicle_t * findVehicleClosest(void);
-adsbVehicle_t * findVehicle(uint8_t index);
+uint8_t findVehiclesClosest(adsbVehicle_t **vehicles, uint8_t maxCount);
 uint8_t getActiveVehiclesCount(void);
 void adsbTtlClean(timeUs_t currentTimeUs);
 adsbVehicleStatus_t* getAdsbStatus(void);
@@ -67,6 +67,12 @@ typedef enum {          // defines are from hdzero code
 #define TX_BUFFER_SIZE 1024
 #define VTX_TIMEOUT 1000 // 1 second timer
 
+#define MSP_V1_FRAME_OVERHEAD 6 // $M>, size, cmd and checksum
+#define WRITE_STRING_OVERHEAD (MSP_V1_FRAME_OVERHEAD + 4) // + subcmd, row, col, attributes
+// Resending a clean character costs 1 byte, starting a new string costs
+// WRITE_STRING_OVERHEAD, so short gaps are sent as part of the string.
+#define MAX_STRING_GAP WRITE_STRING_OVERHEAD
+
 static mspProcessCommandFnPtr mspProcessCommand;
 static mspPort_t mspPort;
 static displayPort_t mspOsdDisplayPort;
@@ -103,6 +109,8 @@ static uint8_t screen[SCREENSIZE];
 static uint8_t attrs[SCREENSIZE];            // font page, blink and other attributes
 static BITARRAY_DECLARE(dirty, SCREENSIZE);  // change status for each character on the screen
 static bool screenCleared;
+static int drawScanPos;                      // where sending dirty characters continues on the next frame
+static int refreshRow = -1;                  // next row to resend in the background, -1 when idle
 static uint8_t screenRows, screenCols;
 static videoSystem_e osdVideoSystem;
 
@@ -188,12 +196,17 @@ static void init(void)
     memset(screen, SYM_BLANK, sizeof(screen));
     memset(attrs, 0, sizeof(attrs));
     BITARRAY_CLR_ALL(dirty);
+    drawScanPos = 0;
+    refreshRow = -1;
 }
 
 static int clearScreen(displayPort_t *displayPort)
 {
     uint8_t subcmd[] = { MSP_DP_CLEAR_SCREEN };
 
+    // Everything is redrawn after a clear, a background refresh would resume mid-screen
+    refreshRow = -1;
+
     if (!cmsInMenu && IS_RC_MODE_ACTIVE(BOXOSD)) { // OSD is off
         output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
         subcmd[0] = MSP_DP_DRAW_SCREEN;
@@ -262,8 +275,49 @@ static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, con
     return 0;
 }
 
+static uint32_t txBytesFree(const displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return mspSerialTxBytesFree(mspPort.port);
+}
+
+static int findNextDirty(int pos)
+{
+    int next = BITARRAY_FIND_FIRST_SET(dirty, pos);
+    if (next < 0 && pos > 0) {
+        next = BITARRAY_FIND_FIRST_SET(dirty, 0);
+    }
+    return next;
+}
+
+// Returns the end (exclusive) of the string of characters starting at pos
+// which can be sent with a single MSP_DP_WRITE_STRING
+static int findStringEnd(int pos)
+{
+    const int endOfLine = (pos / COLS) * COLS + screenCols;
+    const uint8_t page = getAttrPage(attrs[pos]);
+    const uint8_t blink = getAttrBlink(attrs[pos]);
+    int end = pos + 1;
+    int gap = 0;
+
+    for (int next = pos + 1; next < endOfLine; next++) {
+        if (getAttrPage(attrs[next]) != page || getAttrBlink(attrs[next]) != blink) {
+            break;
+        }
+        if (bitArrayGet(dirty, next)) {
+            end = next + 1;
+            gap = 0;
+        } else if (++gap > MAX_STRING_GAP) {
+            break;
+        }
+    }
+
+    return end;
+}
+
 /**
- * Write only changed characters to the VTX
+ * Write only changed characters to the VTX, as long as they fit in the
+ * serial TX buffer. Whatever doesn't fit is sent on the next frame.
  */
 static int drawScreen(displayPort_t *displayPort) // 250Hz
 {
@@ -273,47 +327,42 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         return 0;
     }
 
-    if (osdConfig()->msp_displayport_fullframe_interval >= 0 && (millis() > sendSubFrameMs)) {
-        // For full frame update, first clear the OSD completely
-        uint8_t refreshSubcmd[1];
-        refreshSubcmd[0] = MSP_DP_CLEAR_SCREEN;
-        output(displayPort, MSP_DISPLAYPORT, refreshSubcmd, sizeof(refreshSubcmd));
-        
-        // Then dirty the characters that are not blank, to send all data on this draw.
-        for (unsigned int pos = 0; pos < sizeof(screen); pos++) {
-            if (screen[pos] != SYM_BLANK) {
-                bitArraySet(dirty, pos);
-            }
-        }
-            
+    if (osdConfig()->msp_displayport_fullframe_interval >= 0 && refreshRow < 0 && (millis() > sendSubFrameMs)) {
+        // Start resending the whole screen, a row at a time, to fix
+        // any characters the VTX missed. Blanks are sent too, so there's
+        // no need to clear the screen first.
+        refreshRow = 0;
         sendSubFrameMs = (osdConfig()->msp_displayport_fullframe_interval > 0) ? (millis() + DS2MS(osdConfig()->msp_displayport_fullframe_interval)) : 0;
     }
 
+    // Keep room for the MSP_DP_DRAW_SCREEN that completes the frame
+    int budget = (int)txBytesFree(displayPort) - (MSP_V1_FRAME_OVERHEAD + 1);
     uint8_t subcmd[COLS + 4];
     uint8_t updateCount = 0;
     subcmd[0] = MSP_DP_WRITE_STRING;
 
-    int next = BITARRAY_FIND_FIRST_SET(dirty, 0);
+    // Continue where the previous frame ran out of budget, so every
+    // part of the screen gets updated even when the link is saturated
+    int next = findNextDirty(drawScanPos);
     while (next >= 0) {
-        // Look for sequential dirty characters on the same line for the same font page
         int pos = next;
+        const int end = findStringEnd(pos);
+        const int len = end - pos;
+
+        if (WRITE_STRING_OVERHEAD + len > budget) {
+            break;
+        }
+
         uint8_t row = pos / COLS;
         uint8_t col = pos % COLS;
         uint8_t attributes = 0;
-        int endOfLine = row * COLS + screenCols;
         uint8_t page = getAttrPage(attrs[pos]);
         uint8_t blink = getAttrBlink(attrs[pos]);
 
-        uint8_t len = 4;
-        do {
+        for (int ii = 0; ii < len; ii++, pos++) {
             bitArrayClr(dirty, pos);
-            subcmd[len] = isDJICompatibleVideoSystem(osdConfig()) ? getDJICharacter(screen[pos++], page): screen[pos++];
-            len++;
-
-            if (bitArrayGet(dirty, pos)) {
-                next = pos;
-            }
-        } while (next == pos && next < endOfLine && getAttrPage(attrs[next]) == page && getAttrBlink(attrs[next]) == blink);
+            subcmd[4 + ii] = isDJICompatibleVideoSystem(osdConfig()) ? getDJICharacter(screen[pos], page) : screen[pos];
+        }
 
         if (!isDJICompatibleVideoSystem(osdConfig())) {
             attributes |= (page << DISPLAYPORT_MSP_ATTR_FONTPAGE);
@@ -326,9 +375,26 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         subcmd[1] = row;
         subcmd[2] = col;
         subcmd[3] = attributes;
-        output(displayPort, MSP_DISPLAYPORT, subcmd, len);
+        output(displayPort, MSP_DISPLAYPORT, subcmd, 4 + len);
+        budget -= WRITE_STRING_OVERHEAD + len;
         updateCount++;
-        next = BITARRAY_FIND_FIRST_SET(dirty, pos);
+        next = findNextDirty(end);
+    }
+
+    drawScanPos = next >= 0 ? next : 0;
+
+    // Resend one row per frame in the background. When changes are still
+    // pending the link is saturated and the row is skipped, but the
+    // cursor moves on anyway so the lower rows get their turn.
+    if (refreshRow >= 0) {
+        if (next < 0) {
+            for (int pos = refreshRow * COLS; pos < refreshRow * COLS + screenCols; pos++) {
+                bitArraySet(dirty, pos);
+            }
+        }
+        if (++refreshRow >= screenRows) {
+            refreshRow = -1;
+        }
     }
 
     if (updateCount > 0 || screenCleared) {
@@ -359,12 +425,6 @@ static int screenSize(const displayPort_t *displayPort)
     return (displayPort->rows * displayPort->cols);
 }
 
-static uint32_t txBytesFree(const displayPort_t *displayPort)
-{
-    UNUSED(displayPort);
-    return mspSerialTxBytesFree(mspPort.port);
-}
-
 static bool getFontMetadata(displayFontMetadata_t *metadata, const displayPort_t *displayPort)
 {
     UNUSED(displayPort);
@@ -40,6 +40,9 @@
 
 #define FRSKY_OSD_CMD_RESPONSE_ERROR 0
 
+#define FRSKY_OSD_DRAWING_STATE_STACK_SIZE 4
+#define FRSKY_OSD_DRAWING_STATE_UNKNOWN 0xFF
+
 #define FRSKY_OSD_INFO_INTERVAL_MS 100
 #define FRSKY_OSD_INFO_READY_INTERVAL_MS 5000
 
@@ -233,6 +236,18 @@ typedef struct frskyOSDError_s {
 } frskyOSDError_t;
 
 
+// Shadow copy of the drawing state we've sent to the OSD, used to drop
+// commands that wouldn't change anything. Fields set to
+// FRSKY_OSD_DRAWING_STATE_UNKNOWN are always sent.
+typedef struct frskyOSDDrawingState_s {
+    uint8_t strokeColor;
+    uint8_t fillColor;
+    uint8_t colorInversion;
+    uint8_t strokeWidth;
+    uint8_t outlineType;
+    uint8_t outlineColor;
+} frskyOSDDrawingState_t;
+
 typedef struct frskyOSDState_s {
     struct {
         uint8_t data[FRSKY_OSD_SEND_BUFFER_SIZE];
@@ -263,6 +278,11 @@ typedef struct frskyOSDState_s {
         uint16_t addr;
         osdCharacter_t *chr;
     } recvOsdCharacter;
+    struct {
+        frskyOSDDrawingState_t stack[FRSKY_OSD_DRAWING_STATE_STACK_SIZE];
+        uint8_t depth;
+        uint8_t overflow;
+    } drawing;
     serialPort_t *port;
     baudRate_e baudrate;
     bool keepBaudrate;
@@ -299,6 +319,34 @@ static void frskyOSDResetSendBuffer(void)
     state.sendBuffer.pos = 0;
 }
 
+static frskyOSDDrawingState_t *frskyOSDDrawingState(void)
+{
+    return &state.drawing.stack[state.drawing.depth];
+}
+
+static void frskyOSDInvalidateDrawingState(void)
+{
+    memset(frskyOSDDrawingState(), FRSKY_OSD_DRAWING_STATE_UNKNOWN, sizeof(frskyOSDDrawingState_t));
+}
+
+static void frskyOSDResetDrawingStateCache(void)
+{
+    state.drawing.depth = 0;
+    state.drawing.overflow = 0;
+    frskyOSDInvalidateDrawingState();
+}
+
+// Returns true if the value needs to be sent to the OSD, updating
+// the shadow state.
+static bool frskyOSDUpdateDrawingStateValue(uint8_t *current, uint8_t value)
+{
+    if (*current == value) {
+        return false;
+    }
+    *current = value;
+    return true;
+}
+
 static void frskyOSDProcessCommandU8(uint8_t *crc, uint8_t c)
 {
     while (serialTxBytesFree(state.port) == 0) {
@@ -328,6 +376,7 @@ static void frskyOSDStateReset(serialPort_t *port, baudRate_e baudrate)
 {
     frskyOSDResetReceiveBuffer();
     frskyOSDResetSendBuffer();
+    frskyOSDResetDrawingStateCache();
     state.info.grid.rows = 0;
     state.info.grid.columns = 0;
     state.info.viewport.width = 0;
@@ -683,6 +732,7 @@ void frskyOSDBeginTransaction(frskyOSDTransactionOptions_e opts)
             frskyOSDResetDrawingState();
         }
     } else if (opts & FRSKY_OSD_TRANSACTION_OPT_RESET_DRAWING) {
+        frskyOSDResetDrawingStateCache();
         frskyOSDSendAsyncCommand(OSD_CMD_TRANSACTION_BEGIN_RESET_DRAWING, NULL, 0);
     } else {
         frskyOSDSendAsyncCommand(OSD_CMD_TRANSACTION_BEGIN, NULL, 0);
@@ -940,25 +990,42 @@ void frskyOSDClearScreen(void)
 void frskyOSDSetStrokeColor(frskyOSDColor_e color)
 {
     uint8_t c = color;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_COLOR, &c, sizeof(c));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->strokeColor, c)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_COLOR, &c, sizeof(c));
+    }
 }
 
 void frskyOSDSetFillColor(frskyOSDColor_e color)
 {
     uint8_t c = color;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_FILL_COLOR, &c, sizeof(c));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->fillColor, c)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_FILL_COLOR, &c, sizeof(c));
+    }
 }
 
 void frskyOSDSetStrokeAndFillColor(frskyOSDColor_e color)
 {
+    frskyOSDDrawingState_t *ds = frskyOSDDrawingState();
+    if (ds->strokeColor == color) {
+        frskyOSDSetFillColor(color);
+        return;
+    }
+    if (ds->fillColor == color) {
+        frskyOSDSetStrokeColor(color);
+        return;
+    }
     uint8_t c = color;
+    ds->strokeColor = c;
+    ds->fillColor = c;
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_AND_FILL_COLOR, &c, sizeof(c));
 }
 
 void frskyOSDSetColorInversion(bool inverted)
 {
     uint8_t c = inverted ? 1 : 0;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_COLOR_INVERSION, &c, sizeof(c));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->colorInversion, c)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_COLOR_INVERSION, &c, sizeof(c));
+    }
 }
 
 void frskyOSDSetPixel(int x, int y, frskyOSDColor_e color)
@@ -982,19 +1049,25 @@ void frskyOSDSetPixelToFillColor(int x, int y)
 void frskyOSDSetStrokeWidth(unsigned width)
 {
     uint8_t w = width;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_WIDTH, &w, sizeof(w));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->strokeWidth, w)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_WIDTH, &w, sizeof(w));
+    }
 }
 
 void frskyOSDSetLineOutlineType(frskyOSDLineOutlineType_e outlineType)
 {
     uint8_t type = outlineType;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_TYPE, &type, sizeof(type));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->outlineType, type)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_TYPE, &type, sizeof(type));
+    }
 }
 
 void frskyOSDSetLineOutlineColor(frskyOSDColor_e outlineColor)
 {
     uint8_t color = outlineColor;
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_COLOR, &color, sizeof(color));
+    if (frskyOSDUpdateDrawingStateValue(&frskyOSDDrawingState()->outlineColor, color)) {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_COLOR, &color, sizeof(color));
+    }
 }
 
 void frskyOSDClipToRect(int x, int y, int w, int h)
@@ -1011,6 +1084,7 @@ void frskyOSDClearRect(int x, int y, int w, int h)
 
 void frskyOSDResetDrawingState(void)
 {
+    frskyOSDResetDrawingStateCache();
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_RESET, NULL, 0);
 }
 
@@ -1153,11 +1227,27 @@ void frskyOSDCtmRotate(float r)
 
 void frskyOSDContextPush(void)
 {
+    // The OSD saves its drawing state on push, mirror it in our cache
+    if (state.drawing.overflow == 0 && state.drawing.depth < FRSKY_OSD_DRAWING_STATE_STACK_SIZE - 1) {
+        state.drawing.stack[state.drawing.depth + 1] = state.drawing.stack[state.drawing.depth];
+        state.drawing.depth++;
+    } else {
+        state.drawing.overflow++;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_CONTEXT_PUSH, NULL, 0);
 }
 
 void frskyOSDContextPop(void)
 {
+    if (state.drawing.overflow > 0) {
+        // We couldn't save the state that's being restored
+        state.drawing.overflow--;
+        frskyOSDInvalidateDrawingState();
+    } else if (state.drawing.depth > 0) {
+        state.drawing.depth--;
+    } else {
+        frskyOSDInvalidateDrawingState();
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_CONTEXT_POP, NULL, 0);
 }
 
@@ -103,6 +103,7 @@ typedef struct gpsConfig_s {
     uint8_t gpsMinSats;
     uint8_t ubloxNavHz;
     gpsBaudRate_e autoBaudMax;
+    bool ubloxPvtOnly;
 } gpsConfig_t;
 
 PG_DECLARE(gpsConfig_t, gpsConfig);
@@ -87,19 +87,7 @@ static const char * baudInitDataNMEA[GPS_BAUDRATE_COUNT] = {
 
 static ubx_nav_sig_info satelites[UBLOX_MAX_SIGNALS] = {};
 
-// Packet checksum accumulators
-static uint8_t _ck_a;
-static uint8_t _ck_b;
-
-// State machine state
-static bool _skip_packet;
-static uint8_t _step;
-static uint8_t _msg_id;
-static uint16_t _payload_length;
-static uint16_t _payload_counter;
-
 static uint8_t next_fix_type;
-static uint8_t _class;
 static uint8_t _ack_state;
 static uint8_t _ack_waiting_msg;
 
@@ -591,303 +579,295 @@ static uint32_t gpsDecodeHardwareVersion(const char * szBuf, unsigned nBufSize)
     return UBX_HW_VERSION_UNKNOWN;
 }
 
-static bool gpsParseFrameUBLOX(void)
+static void ubloxHandleNavPosllh(const void *payload, uint16_t length)
 {
-    switch (_msg_id) {
-    case MSG_POSLLH:
-        gpsSolDRV.llh.lon = _buffer.posllh.longitude;
-        gpsSolDRV.llh.lat = _buffer.posllh.latitude;
-        gpsSolDRV.llh.alt = _buffer.posllh.altitude_msl / 10;  //alt in cm
-        gpsSolDRV.eph = gpsConstrainEPE(_buffer.posllh.horizontal_accuracy / 10);
-        gpsSolDRV.epv = gpsConstrainEPE(_buffer.posllh.vertical_accuracy / 10);
-        gpsSolDRV.flags.validEPE = true;
-        if (next_fix_type != GPS_NO_FIX)
-            gpsSolDRV.fixType = next_fix_type;
-        _new_position = true;
-        break;
-    case MSG_STATUS:
-        next_fix_type = gpsMapFixType(_buffer.status.fix_status & NAV_STATUS_FIX_VALID, _buffer.status.fix_type);
-        if (next_fix_type == GPS_NO_FIX)
-            gpsSolDRV.fixType = GPS_NO_FIX;
-        break;
-    case MSG_SOL:
-        next_fix_type = gpsMapFixType(_buffer.solution.fix_status & NAV_STATUS_FIX_VALID, _buffer.solution.fix_type);
-        if (next_fix_type == GPS_NO_FIX)
-            gpsSolDRV.fixType = GPS_NO_FIX;
-        gpsSolDRV.numSat = _buffer.solution.satellites;
-        gpsSolDRV.hdop = gpsConstrainHDOP(_buffer.solution.position_DOP);
-        break;
-    case MSG_VELNED:
-        gpsSolDRV.groundSpeed = _buffer.velned.speed_2d;    // cm/s
-        gpsSolDRV.groundCourse = (uint16_t) (_buffer.velned.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSolDRV.velNED[X] = _buffer.velned.ned_north;
-        gpsSolDRV.velNED[Y] = _buffer.velned.ned_east;
-        gpsSolDRV.velNED[Z] = _buffer.velned.ned_down;
-        gpsSolDRV.flags.validVelNE = true;
-        gpsSolDRV.flags.validVelD = true;
-        _new_speed = true;
-        break;
-    case MSG_TIMEUTC:
-        if (UBX_VALID_GPS_DATE_TIME(_buffer.timeutc.valid)) {
-            gpsSolDRV.time.year = _buffer.timeutc.year;
-            gpsSolDRV.time.month = _buffer.timeutc.month;
-            gpsSolDRV.time.day = _buffer.timeutc.day;
-            gpsSolDRV.time.hours = _buffer.timeutc.hour;
-            gpsSolDRV.time.minutes = _buffer.timeutc.min;
-            gpsSolDRV.time.seconds = _buffer.timeutc.sec;
-            gpsSolDRV.time.millis = _buffer.timeutc.nano / (1000*1000);
-
-            gpsSolDRV.flags.validTime = true;
-        } else {
-            gpsSolDRV.flags.validTime = false;
-        }
-        break;
-    case MSG_PVT:
-        {
-            static int pvtCount = 0;
-            DEBUG_SET(DEBUG_GPS, 0, pvtCount++);
-        }
-
-        gpsState.flags.pvt = 1;
-        next_fix_type = gpsMapFixType(_buffer.pvt.fix_status & NAV_STATUS_FIX_VALID, _buffer.pvt.fix_type);
+    UNUSED(length);
+    const ubx_nav_posllh *posllh = payload;
+
+    gpsSolDRV.llh.lon = posllh->longitude;
+    gpsSolDRV.llh.lat = posllh->latitude;
+    gpsSolDRV.llh.alt = posllh->altitude_msl / 10;  //alt in cm
+    gpsSolDRV.eph = gpsConstrainEPE(posllh->horizontal_accuracy / 10);
+    gpsSolDRV.epv = gpsConstrainEPE(posllh->vertical_accuracy / 10);
+    gpsSolDRV.flags.validEPE = true;
+    if (next_fix_type != GPS_NO_FIX)
         gpsSolDRV.fixType = next_fix_type;
-        gpsSolDRV.llh.lon = _buffer.pvt.longitude;
-        gpsSolDRV.llh.lat = _buffer.pvt.latitude;
-        gpsSolDRV.llh.alt = _buffer.pvt.altitude_msl / 10;  //alt in cm
-        gpsSolDRV.velNED[X]=_buffer.pvt.ned_north / 10;  // to cm/s
-        gpsSolDRV.velNED[Y]=_buffer.pvt.ned_east / 10;   // to cm/s
-        gpsSolDRV.velNED[Z]=_buffer.pvt.ned_down / 10;   // to cm/s
-        gpsSolDRV.groundSpeed = _buffer.pvt.speed_2d / 10;    // to cm/s
-        gpsSolDRV.groundCourse = (uint16_t) (_buffer.pvt.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSolDRV.numSat = _buffer.pvt.satellites;
-        gpsSolDRV.eph = gpsConstrainEPE(_buffer.pvt.horizontal_accuracy / 10);
-        gpsSolDRV.epv = gpsConstrainEPE(_buffer.pvt.vertical_accuracy / 10);
-        gpsSolDRV.hdop = gpsConstrainHDOP(_buffer.pvt.position_DOP);
-        gpsSolDRV.flags.validVelNE = true;
-        gpsSolDRV.flags.validVelD = true;
-        gpsSolDRV.flags.validEPE = true;
-
-        if (UBX_VALID_GPS_DATE_TIME(_buffer.pvt.valid)) {
-            gpsSolDRV.time.year = _buffer.pvt.year;
-            gpsSolDRV.time.month = _buffer.pvt.month;
-            gpsSolDRV.time.day = _buffer.pvt.day;
-            gpsSolDRV.time.hours = _buffer.pvt.hour;
-            gpsSolDRV.time.minutes = _buffer.pvt.min;
-            gpsSolDRV.time.seconds = _buffer.pvt.sec;
-            gpsSolDRV.time.millis = _buffer.pvt.nano / (1000*1000);
-
-            gpsSolDRV.flags.validTime = true;
-        } else {
-            gpsSolDRV.flags.validTime = false;
-        }
+    _new_position = true;
+}
 
-        _new_position = true;
-        _new_speed = true;
-        break;
-    case MSG_VER:
-        if (_class == CLASS_MON) {
-            gpsState.hwVersion = gpsDecodeHardwareVersion(_buffer.ver.hwVersion, sizeof(_buffer.ver.hwVersion));
-            if (gpsState.hwVersion >= UBX_HW_VERSION_UBLOX8) {
-                if (_buffer.ver.swVersion[9] > '2' || true) {
-                    // check extensions;
-                    // after hw + sw vers; each is 30 bytes
-                    bool found = false;
-                    for (int j = 40; j < _payload_length && !found; j += 30)
-                    {
-                        // Example content: GPS;GAL;BDS;GLO
-                        if (strnstr((const char *)(_buffer.bytes + j), "GAL", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_GALILEO_MASK;
-                            found = true;
-                        }
-                        if (strnstr((const char *)(_buffer.bytes + j), "BDS", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_BEIDOU_MASK;
-                            found = true;
-                        }
-                        if (strnstr((const char *)(_buffer.bytes + j), "GLO", 30))
-                        {
-                            ubx_capabilities.supported |= UBX_MON_GNSS_GLONASS_MASK;
-                            found = true;
-                        }
-                    }
-                }
-                for(int j = 40; j < _payload_length; j += 30) {
-                    if (strnstr((const char *)(_buffer.bytes + j), "PROTVER", 30)) {
-                        gpsDecodeProtocolVersion((const char *)(_buffer.bytes + j), 30);
-                        break;
-                    }
-                }
-            }
-        }
-        break;
-    case MSG_MON_GNSS:
-        if(_class == CLASS_MON) {
-            if (_buffer.gnss.version == 0) {
-                ubx_capabilities.supported = _buffer.gnss.supported;
-                ubx_capabilities.defaultGnss = _buffer.gnss.defaultGnss;
-                ubx_capabilities.enabledGnss = _buffer.gnss.enabled;
-                ubx_capabilities.capMaxGnss = _buffer.gnss.maxConcurrent;
-                gpsState.lastCapaUpdMs = millis();
-            }
-        }
-        break;
-    case MSG_NAV_SAT:
-        if (_class == CLASS_NAV) {
-            static int satInfoCount = 0;
-            gpsState.flags.sat = 1;
-            DEBUG_SET(DEBUG_GPS, 1, satInfoCount++);
-            DEBUG_SET(DEBUG_GPS, 3, _buffer.svinfo.numSvs);
-            if (!gpsState.flags.pvt) { // PVT is the prefered source
-                gpsSolDRV.numSat = _buffer.svinfo.numSvs;
-            }
+static void ubloxHandleNavStatus(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_nav_status *status = payload;
 
-            for(int i = 0; i < MIN(_buffer.svinfo.numSvs, UBLOX_MAX_SIGNALS); ++i) {
-                ubloxNavSat2NavSig(&_buffer.svinfo.channel[i], &satelites[i]);
-            }
-            for(int i =_buffer.svinfo.numSvs; i < UBLOX_MAX_SIGNALS; ++i) {
-                satelites->gnssId = 0xFF;
-                satelites->svId = 0xFF;
-            }
+    next_fix_type = gpsMapFixType(status->fix_status & NAV_STATUS_FIX_VALID, status->fix_type);
+    if (next_fix_type == GPS_NO_FIX)
+        gpsSolDRV.fixType = GPS_NO_FIX;
+}
+
+static void ubloxHandleNavSol(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_nav_solution *solution = payload;
+
+    next_fix_type = gpsMapFixType(solution->fix_status & NAV_STATUS_FIX_VALID, solution->fix_type);
+    if (next_fix_type == GPS_NO_FIX)
+        gpsSolDRV.fixType = GPS_NO_FIX;
+    gpsSolDRV.numSat = solution->satellites;
+    gpsSolDRV.hdop = gpsConstrainHDOP(solution->position_DOP);
+}
+
+static void ubloxHandleNavVelned(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_nav_velned *velned = payload;
+
+    gpsSolDRV.groundSpeed = velned->speed_2d;    // cm/s
+    gpsSolDRV.groundCourse = (uint16_t) (velned->heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+    gpsSolDRV.velNED[X] = velned->ned_north;
+    gpsSolDRV.velNED[Y] = velned->ned_east;
+    gpsSolDRV.velNED[Z] = velned->ned_down;
+    gpsSolDRV.flags.validVelNE = true;
+    gpsSolDRV.flags.validVelD = true;
+    _new_speed = true;
+}
+
+static void ubloxHandleNavTimeUtc(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_nav_timeutc *timeutc = payload;
+
+    if (UBX_VALID_GPS_DATE_TIME(timeutc->valid)) {
+        gpsSolDRV.time.year = timeutc->year;
+        gpsSolDRV.time.month = timeutc->month;
+        gpsSolDRV.time.day = timeutc->day;
+        gpsSolDRV.time.hours = timeutc->hour;
+        gpsSolDRV.time.minutes = timeutc->min;
+        gpsSolDRV.time.seconds = timeutc->sec;
+        gpsSolDRV.time.millis = timeutc->nano / (1000*1000);
+
+        gpsSolDRV.flags.validTime = true;
+    } else {
+        gpsSolDRV.flags.validTime = false;
+    }
+}
+
+static void ubloxHandleNavPvt(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_nav_pvt *pvt = payload;
+
+    {
+        static int pvtCount = 0;
+        DEBUG_SET(DEBUG_GPS, 0, pvtCount++);
+    }
+
+    gpsState.flags.pvt = 1;
+    next_fix_type = gpsMapFixType(pvt->fix_status & NAV_STATUS_FIX_VALID, pvt->fix_type);
+    gpsSolDRV.fixType = next_fix_type;
+    gpsSolDRV.llh.lon = pvt->longitude;
+    gpsSolDRV.llh.lat = pvt->latitude;
+    gpsSolDRV.llh.alt = pvt->altitude_msl / 10;  //alt in cm
+    gpsSolDRV.velNED[X] = pvt->ned_north / 10;  // to cm/s
+    gpsSolDRV.velNED[Y] = pvt->ned_east / 10;   // to cm/s
+    gpsSolDRV.velNED[Z] = pvt->ned_down / 10;   // to cm/s
+    gpsSolDRV.groundSpeed = pvt->speed_2d / 10;    // to cm/s
+    gpsSolDRV.groundCourse = (uint16_t) (pvt->heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+    gpsSolDRV.numSat = pvt->satellites;
+    gpsSolDRV.eph = gpsConstrainEPE(pvt->horizontal_accuracy / 10);
+    gpsSolDRV.epv = gpsConstrainEPE(pvt->vertical_accuracy / 10);
+    gpsSolDRV.hdop = gpsConstrainHDOP(pvt->position_DOP);
+    gpsSolDRV.flags.validVelNE = true;
+    gpsSolDRV.flags.validVelD = true;
+    gpsSolDRV.flags.validEPE = true;
+
+    if (UBX_VALID_GPS_DATE_TIME(pvt->valid)) {
+        gpsSolDRV.time.year = pvt->year;
+        gpsSolDRV.time.month = pvt->month;
+        gpsSolDRV.time.day = pvt->day;
+        gpsSolDRV.time.hours = pvt->hour;
+        gpsSolDRV.time.minutes = pvt->min;
+        gpsSolDRV.time.seconds = pvt->sec;
+        gpsSolDRV.time.millis = pvt->nano / (1000*1000);
+
+        gpsSolDRV.flags.validTime = true;
+    } else {
+        gpsSolDRV.flags.validTime = false;
+    }
+
+    _new_position = true;
+    _new_speed = true;
+}
+
+static void ubloxHandleNavSat(const void *payload, uint16_t length)
+{
+    const ubx_nav_svinfo *svinfo = payload;
+    static int satInfoCount = 0;
+
+    gpsState.flags.sat = 1;
+    DEBUG_SET(DEBUG_GPS, 1, satInfoCount++);
+    DEBUG_SET(DEBUG_GPS, 3, svinfo->numSvs);
+    if (!gpsState.flags.pvt) { // PVT is the prefered source
+        gpsSolDRV.numSat = svinfo->numSvs;
+    }
+
+    // Never trust numSvs beyond what was actually received
+    const int received = (length - offsetof(ubx_nav_svinfo, channel)) / sizeof(ubx_nav_svinfo_channel);
+    const int count = MIN(MIN(svinfo->numSvs, UBLOX_MAX_SIGNALS), received);
+    for (int i = 0; i < count; ++i) {
+        ubloxNavSat2NavSig(&svinfo->channel[i], &satelites[i]);
+    }
+    for (int i = count; i < UBLOX_MAX_SIGNALS; ++i) {
+        satelites[i].gnssId = 0xFF;
+        satelites[i].svId = 0xFF;
+    }
+}
+
+static void ubloxHandleNavSig(const void *payload, uint16_t length)
+{
+    const ubx_nav_sig *navsig = payload;
+
+    if (navsig->version != 0) {
+        return;
+    }
+
+    static int sigInfoCount = 0;
+    DEBUG_SET(DEBUG_GPS, 2, sigInfoCount++);
+    DEBUG_SET(DEBUG_GPS, 4, navsig->numSigs);
+    gpsState.flags.sig = 1;
+
+    if (navsig->numSigs > 0) {
+        // Signal blocks share the layout of satelites[], so take them in one go
+        const int received = (length - offsetof(ubx_nav_sig, sig)) / sizeof(ubx_nav_sig_info);
+        const int count = MIN(MIN(navsig->numSigs, UBLOX_MAX_SIGNALS), received);
+        memcpy(satelites, navsig->sig, count * sizeof(ubx_nav_sig_info));
+        for (int i = count; i < UBLOX_MAX_SIGNALS; ++i) {
+            satelites[i].svId = 0xFF; // no used
+            satelites[i].gnssId = 0xFF;
         }
-        break;
-    case MSG_NAV_SIG:
-        if (_class == CLASS_NAV && _buffer.navsig.version == 0) {
-            static int sigInfoCount = 0;
-            DEBUG_SET(DEBUG_GPS, 2, sigInfoCount++);
-            DEBUG_SET(DEBUG_GPS, 4, _buffer.navsig.numSigs);
-            gpsState.flags.sig = 1;
-
-            if(_buffer.navsig.numSigs > 0) 
+    }
+}
+
+static void ubloxHandleMonVer(const void *payload, uint16_t length)
+{
+    const ubx_mon_ver *ver = payload;
+    const char *bytes = payload;
+
+    gpsState.hwVersion = gpsDecodeHardwareVersion(ver->hwVersion, sizeof(ver->hwVersion));
+    if (gpsState.hwVersion >= UBX_HW_VERSION_UBLOX8) {
+        if (ver->swVersion[9] > '2' || true) {
+            // check extensions;
+            // after hw + sw vers; each is 30 bytes
+            bool found = false;
+            for (int j = 40; j < length && !found; j += 30)
             {
-                for(int i=0; i < MIN(UBLOX_MAX_SIGNALS, _buffer.navsig.numSigs); ++i)
+                // Example content: GPS;GAL;BDS;GLO
+                if (strnstr(bytes + j, "GAL", 30))
+                {
+                    ubx_capabilities.supported |= UBX_MON_GNSS_GALILEO_MASK;
+                    found = true;
+                }
+                if (strnstr(bytes + j, "BDS", 30))
                 {
-                    memcpy(&satelites[i], &_buffer.navsig.sig[i], sizeof(ubx_nav_sig_info));
+                    ubx_capabilities.supported |= UBX_MON_GNSS_BEIDOU_MASK;
+                    found = true;
                 }
-                for(int i = _buffer.navsig.numSigs; i < UBLOX_MAX_SIGNALS; ++i)
+                if (strnstr(bytes + j, "GLO", 30))
                 {
-                    satelites[i].svId = 0xFF; // no used
-                    satelites[i].gnssId = 0xFF;
+                    ubx_capabilities.supported |= UBX_MON_GNSS_GLONASS_MASK;
+                    found = true;
                 }
             }
         }
-        break;
-    case MSG_ACK_ACK:
-        if ((_ack_state == UBX_ACK_WAITING) && (_buffer.ack.msg == _ack_waiting_msg)) {
-            _ack_state = UBX_ACK_GOT_ACK;
-        }
-        break;
-    case MSG_ACK_NACK:
-        if ((_ack_state == UBX_ACK_WAITING) && (_buffer.ack.msg == _ack_waiting_msg)) {
-            _ack_state = UBX_ACK_GOT_NAK;
+        for(int j = 40; j < length; j += 30) {
+            if (strnstr(bytes + j, "PROTVER", 30)) {
+                gpsDecodeProtocolVersion(bytes + j, 30);
+                break;
+            }
         }
-        break;
-    default:
-        return false;
     }
+}
 
-    DEBUG_SET(DEBUG_GPS, 5, gpsState.flags.pvt);
-    DEBUG_SET(DEBUG_GPS, 6, gpsState.flags.sat);
-    DEBUG_SET(DEBUG_GPS, 7, gpsState.flags.sig);
-
-    // we only return true when we get new position and speed data
-    // this ensures we don't use stale data
-    if (_new_position && _new_speed) {
-        _new_speed = _new_position = false;
-        return true;
+static void ubloxHandleMonGnss(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_mon_gnss *gnss = payload;
+
+    if (gnss->version == 0) {
+        ubx_capabilities.supported = gnss->supported;
+        ubx_capabilities.defaultGnss = gnss->defaultGnss;
+        ubx_capabilities.enabledGnss = gnss->enabled;
+        ubx_capabilities.capMaxGnss = gnss->maxConcurrent;
+        gpsState.lastCapaUpdMs = millis();
     }
+}
 
-    return false;
+static void ubloxHandleAckAck(const void *payload, uint16_t length)
+{
+    UNUSED(length);
+    const ubx_ack_ack *ack = payload;
+
+    if ((_ack_state == UBX_ACK_WAITING) && (ack->msg == _ack_waiting_msg)) {
+        _ack_state = UBX_ACK_GOT_ACK;
+    }
 }
 
-static bool gpsNewFrameUBLOX(uint8_t data)
+static void ubloxHandleAckNack(const void *payload, uint16_t length)
 {
-    bool parsed = false;
+    UNUSED(length);
+    const ubx_ack_ack *ack = payload;
 
-    switch (_step) {
-        case 0: // Sync char 1 (0xB5)
-            if (PREAMBLE1 == data) {
-                _skip_packet = false;
-                _step++;
-            }
-            break;
-        case 1: // Sync char 2 (0x62)
-            if (PREAMBLE2 != data) {
-                _step = 0;
-                break;
-            }
-            _step++;
-            break;
-        case 2: // Class
-            _step++;
-            _class = data;
-            _ck_b = _ck_a = data;   // reset the checksum accumulators
-            break;
-        case 3: // Id
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _msg_id = data;
-            break;
-        case 4: // Payload length (part 1)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length = data; // payload length low byte
-            break;
-        case 5: // Payload length (part 2)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length |= (uint16_t)(data << 8);
-            if (_payload_length > MAX_UBLOX_PAYLOAD_SIZE ) {
-                // we can't receive the whole packet, just log the error and start searching for the next packet.
-                gpsStats.errors++;
-                _step = 0;
-                break;
-            }
-            // prepare to receive payload
-            _payload_counter = 0;
-            if (_payload_length == 0) {
-                _step = 7;
-            }
-            break;
-        case 6:
-            _ck_b += (_ck_a += data);       // checksum byte
-            if (_payload_counter < MAX_UBLOX_PAYLOAD_SIZE) {
-                _buffer.bytes[_payload_counter] = data;
-            }
-            // NOTE: check counter BEFORE increasing so that a payload_size of 65535 is correctly handled.  This can happen if garbage data is received.
-            if (_payload_counter ==  _payload_length - 1) {
-                _step++;
-            }
-            _payload_counter++;
-            break;
-        case 7:
-            _step++;
-            if (_ck_a != data) {
-                _skip_packet = true;          // bad checksum
-                gpsStats.errors++;
-                _step = 0;
-            }
-            break;
-        case 8:
-            _step = 0;
+    if ((_ack_state == UBX_ACK_WAITING) && (ack->msg == _ack_waiting_msg)) {
+        _ack_state = UBX_ACK_GOT_NAK;
+    }
+}
 
-            if (_ck_b != data) {
-                gpsStats.errors++;
-                break;              // bad checksum
-            }
+// Most frequent messages first, PVT leads as it is the only one at full rate on modern receivers
+static const ubxMessageHandler_t ubxMessageHandlers[] = {
+    { CLASS_NAV, MSG_PVT,       sizeof(ubx_nav_pvt),                 ubloxHandleNavPvt },
+    { CLASS_NAV, MSG_NAV_SIG,   offsetof(ubx_nav_sig, sig),          ubloxHandleNavSig },
+    { CLASS_NAV, MSG_NAV_SAT,   offsetof(ubx_nav_svinfo, channel),   ubloxHandleNavSat },
+    { CLASS_NAV, MSG_POSLLH,    sizeof(ubx_nav_posllh),              ubloxHandleNavPosllh },
+    { CLASS_NAV, MSG_VELNED,    sizeof(ubx_nav_velned),              ubloxHandleNavVelned },
+    { CLASS_NAV, MSG_STATUS,    sizeof(ubx_nav_status),              ubloxHandleNavStatus },
+    { CLASS_NAV, MSG_SOL,       sizeof(ubx_nav_solution),            ubloxHandleNavSol },
+    { CLASS_NAV, MSG_TIMEUTC,   sizeof(ubx_nav_timeutc),             ubloxHandleNavTimeUtc },
+    { CLASS_ACK, MSG_ACK_ACK,   sizeof(ubx_ack_ack),                 ubloxHandleAckAck },
+    { CLASS_ACK, MSG_ACK_NACK,  sizeof(ubx_ack_ack),                 ubloxHandleAckNack },
+    { CLASS_MON, MSG_VER,       sizeof(ubx_mon_ver),                 ubloxHandleMonVer },
+    { CLASS_MON, MSG_MON_GNSS,  sizeof(ubx_mon_gnss),                ubloxHandleMonGnss },
+};
+
+static ubxFrameParser_t ubxParser;
 
+static bool gpsNewFrameUBLOX(uint8_t data)
+{
+    switch (ubloxFrameParserFeed(&ubxParser, data)) {
+        case UBX_FRAME_PENDING:
+            return false;
+        case UBX_FRAME_ERROR:
+            gpsStats.errors++;
+            return false;
+        case UBX_FRAME_SKIPPED:
+            gpsStats.packetCount++;
+            return false;
+        case UBX_FRAME_DISPATCHED:
             gpsStats.packetCount++;
+            break;
+    }
 
-            if (_skip_packet) {
-                break;
-            }
+    DEBUG_SET(DEBUG_GPS, 5, gpsState.flags.pvt);
+    DEBUG_SET(DEBUG_GPS, 6, gpsState.flags.sat);
+    DEBUG_SET(DEBUG_GPS, 7, gpsState.flags.sig);
 
-            if (gpsParseFrameUBLOX()) {
-                parsed = true;
-            }
+    // we only return true when we get new position and speed data
+    // this ensures we don't use stale data
+    if (_new_position && _new_speed) {
+        _new_speed = _new_position = false;
+        return true;
     }
 
-    return parsed;
+    return false;
 }
 
 static uint16_t hz2rate(uint8_t hz)
@@ -1013,7 +993,7 @@ STATIC_PROTOTHREAD(gpsConfigure)
             {UBLOX_CFG_MSGOUT_NAV_VELNED_UART1, 0}, // 2
             {UBLOX_CFG_MSGOUT_NAV_TIMEUTC_UART1, 0}, // 3
             {UBLOX_CFG_MSGOUT_NAV_PVT_UART1, 1}, // 4
-            {UBLOX_CFG_MSGOUT_NAV_SIG_UART1, 1}, // 5
+            {UBLOX_CFG_MSGOUT_NAV_SIG_UART1, gpsState.gpsConfig->ubloxPvtOnly ? 0 : 1}, // 5
             {UBLOX_CFG_MSGOUT_NAV_SAT_UART1, 0}  // 6
         };
 
@@ -1041,7 +1021,7 @@ STATIC_PROTOTHREAD(gpsConfigure)
         configureMSG(MSG_CLASS_UBX, MSG_PVT, 1);
         ptWait(_ack_state == UBX_ACK_GOT_ACK || _ack_state == UBX_ACK_GOT_NAK);
 
-        configureMSG(MSG_CLASS_UBX, MSG_NAV_SAT, 1);
+        configureMSG(MSG_CLASS_UBX, MSG_NAV_SAT, gpsState.gpsConfig->ubloxPvtOnly ? 0 : 1);
         ptWait(_ack_state == UBX_ACK_GOT_ACK || _ack_state == UBX_ACK_GOT_NAK);
     } else { // Really old stuff, consider upgrading :), ols setting API, no PVT or NAV_SAT or NAV_SIG
         // TODO: remove in INAV 9.0.0
@@ -1129,6 +1109,8 @@ STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
 {
     ptBegin(gpsProtocolReceiverThread);
 
+    ubloxFrameParserInit(&ubxParser, ubxMessageHandlers, ARRAYLEN(ubxMessageHandlers), _buffer.bytes, sizeof(_buffer));
+
     while (1) {
         // Wait until there are bytes to consume
         ptWait(serialRxBytesWaiting(gpsState.gpsPort));
@@ -113,4 +113,102 @@ void ubloxNavSat2NavSig(const ubx_nav_svinfo_channel *navSat, ubx_nav_sig_info *
                         // bit7: carrier correction used
                         // bit8: doper corrections used
     //uint8_t reserved[4];
-}
\ No newline at end of file
+}
+
+void ubloxFrameParserInit(ubxFrameParser_t *parser, const ubxMessageHandler_t *table, uint8_t tableCount, uint8_t *buffer, uint16_t bufferSize)
+{
+    memset(parser, 0, sizeof(ubxFrameParser_t));
+    parser->table = table;
+    parser->tableCount = tableCount;
+    parser->buffer = buffer;
+    parser->bufferSize = bufferSize;
+}
+
+const ubxMessageHandler_t *ubloxFindMessageHandler(const ubxMessageHandler_t *table, uint8_t tableCount, uint8_t msgClass, uint8_t msgId)
+{
+    for (int i = 0; i < tableCount; i++) {
+        if (table[i].msgClass == msgClass && table[i].msgId == msgId) {
+            return &table[i];
+        }
+    }
+
+    return NULL;
+}
+
+ubxFrameResult_e ubloxFrameParserFeed(ubxFrameParser_t *parser, uint8_t data)
+{
+    switch (parser->step) {
+        case 0: // Sync char 1 (0xB5)
+            if (data == PREAMBLE1) {
+                parser->step++;
+            }
+            break;
+        case 1: // Sync char 2 (0x62)
+            parser->step = (data == PREAMBLE2) ? 2 : 0;
+            break;
+        case 2: // Class
+            parser->step++;
+            parser->msgClass = data;
+            parser->ckB = parser->ckA = data;   // reset the checksum accumulators
+            break;
+        case 3: // Id
+            parser->step++;
+            parser->ckB += (parser->ckA += data);
+            parser->msgId = data;
+            break;
+        case 4: // Payload length (part 1)
+            parser->step++;
+            parser->ckB += (parser->ckA += data);
+            parser->payloadLength = data;
+            break;
+        case 5: // Payload length (part 2)
+            parser->step++;
+            parser->ckB += (parser->ckA += data);
+            parser->payloadLength |= (uint16_t)(data << 8);
+            if (parser->payloadLength > parser->bufferSize) {
+                // Most likely garbage, start searching for the next packet right away
+                parser->step = 0;
+                return UBX_FRAME_ERROR;
+            }
+
+            // Only frames somebody is interested in are copied into the receive buffer
+            parser->handler = ubloxFindMessageHandler(parser->table, parser->tableCount, parser->msgClass, parser->msgId);
+            if (parser->handler && parser->payloadLength < parser->handler->minLength) {
+                parser->handler = NULL;
+            }
+
+            parser->payloadCounter = 0;
+            if (parser->payloadLength == 0) {
+                parser->step = 7;
+            }
+            break;
+        case 6: // Payload
+            parser->ckB += (parser->ckA += data);
+            if (parser->handler) {
+                parser->buffer[parser->payloadCounter] = data;
+            }
+            if (++parser->payloadCounter == parser->payloadLength) {
+                parser->step++;
+            }
+            break;
+        case 7: // Checksum A
+            if (parser->ckA != data) {
+                parser->step = 0;
+                return UBX_FRAME_ERROR;
+            }
+            parser->step++;
+            break;
+        case 8: // Checksum B
+            parser->step = 0;
+            if (parser->ckB != data) {
+                return UBX_FRAME_ERROR;
+            }
+            if (!parser->handler) {
+                return UBX_FRAME_SKIPPED;
+            }
+            parser->handler->fn(parser->buffer, parser->payloadLength);
+            return UBX_FRAME_DISPATCHED;
+    }
+
+    return UBX_FRAME_PENDING;
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "gps_ublox.h"
@@ -32,6 +33,43 @@ void ublox_update_checksum(uint8_t *data, uint8_t len, uint8_t *ck_a, uint8_t *c
 
 void ubloxNavSat2NavSig(const ubx_nav_svinfo_channel *navSat, ubx_nav_sig_info *navSig);
 
+// Handlers get a pointer straight into the parser receive buffer; it is only valid for the duration of the call
+typedef void (*ubxMessageHandlerFnPtr)(const void *payload, uint16_t length);
+
+typedef struct ubxMessageHandler_s {
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t minLength;         // Shorter payloads are checksummed but never stored nor dispatched
+    ubxMessageHandlerFnPtr fn;
+} ubxMessageHandler_t;
+
+typedef enum {
+    UBX_FRAME_PENDING = 0,      // Frame still being received
+    UBX_FRAME_DISPATCHED,       // Valid frame, handler was called
+    UBX_FRAME_SKIPPED,          // Valid frame without a handler, payload was not stored
+    UBX_FRAME_ERROR,            // Bad checksum or oversized frame
+} ubxFrameResult_e;
+
+typedef struct ubxFrameParser_s {
+    const ubxMessageHandler_t *table;
+    uint8_t tableCount;
+    uint8_t *buffer;
+    uint16_t bufferSize;
+
+    const ubxMessageHandler_t *handler;     // Handler of the frame being received, NULL when the payload is discarded
+    uint8_t step;
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t payloadLength;
+    uint16_t payloadCounter;
+    uint8_t ckA;
+    uint8_t ckB;
+} ubxFrameParser_t;
+
+void ubloxFrameParserInit(ubxFrameParser_t *parser, const ubxMessageHandler_t *table, uint8_t tableCount, uint8_t *buffer, uint16_t bufferSize);
+const ubxMessageHandler_t *ubloxFindMessageHandler(const ubxMessageHandler_t *table, uint8_t tableCount, uint8_t msgClass, uint8_t msgId);
+ubxFrameResult_e ubloxFrameParserFeed(ubxFrameParser_t *parser, uint8_t data);
+
 #ifdef __cplusplus
 }
 #endif
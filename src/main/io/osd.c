@@ -288,7 +288,7 @@ static void osdFormatDistanceSymbol(char *buff, int32_t dist, uint8_t decimals,
     case OSD_UNIT_UK:
         FALLTHROUGH;
     case OSD_UNIT_IMPERIAL:
-        if (osdFormatCentiNumber(buff, CENTIMETERS_TO_CENTIFEET(dist), FEET_PER_MILE, decimals, 3, digits, false)) {
+        if (osdFormatCentiNumber(buff, osdCentimetersToCentifeet(dist), FEET_PER_MILE, decimals, 3, digits, false)) {
             buff[sym_index] = symbol_mi;
         } else {
             buff[sym_index] = symbol_ft;
@@ -306,7 +306,7 @@ static void osdFormatDistanceSymbol(char *buff, int32_t dist, uint8_t decimals,
         buff[sym_index + 1] = '\0';
         break;
     case OSD_UNIT_GA:
-        if (osdFormatCentiNumber(buff, CENTIMETERS_TO_CENTIFEET(dist), (uint32_t)FEET_PER_NAUTICALMILE, decimals, 3, digits, false)) {
+        if (osdFormatCentiNumber(buff, osdCentimetersToCentifeet(dist), (uint32_t)FEET_PER_NAUTICALMILE, decimals, 3, digits, false)) {
             buff[sym_index] = symbol_nm;
         } else {
             buff[sym_index] = symbol_ft;
@@ -327,7 +327,7 @@ static void osdFormatDistanceStr(char *buff, int32_t dist)
     case OSD_UNIT_UK:
         FALLTHROUGH;
     case OSD_UNIT_IMPERIAL:
-        centifeet = CENTIMETERS_TO_CENTIFEET(dist);
+        centifeet = osdCentimetersToCentifeet(dist);
         if (abs(centifeet) < FEET_PER_MILE * 100 / 2) {
             // Show feet when dist < 0.5mi
             tfp_sprintf(buff, "%d%c", (int)(centifeet / 100), SYM_FT);
@@ -350,7 +350,7 @@ static void osdFormatDistanceStr(char *buff, int32_t dist)
         }
         break;
     case OSD_UNIT_GA:
-         centifeet = CENTIMETERS_TO_CENTIFEET(dist);
+         centifeet = osdCentimetersToCentifeet(dist);
         if (abs(centifeet) < 100000) {
             // Show feet when dist < 1000ft
             tfp_sprintf(buff, "%d%c", (int)(centifeet / 100), SYM_FT);
@@ -375,11 +375,11 @@ static int32_t osdConvertVelocityToUnit(int32_t vel)
     case OSD_UNIT_METRIC_MPH:
         FALLTHROUGH;
     case OSD_UNIT_IMPERIAL:
-        return CMSEC_TO_CENTIMPH(vel) / 100; // Convert to mph
+        return osdCmsToCentiMph(vel) / 100; // Convert to mph
     case OSD_UNIT_METRIC:
-        return CMSEC_TO_CENTIKPH(vel) / 100;   // Convert to kmh
+        return osdCmsToCentiKph(vel) / 100;   // Convert to kmh
     case OSD_UNIT_GA:
-        return CMSEC_TO_CENTIKNOTS(vel) / 100; // Convert to Knots
+        return osdCmsToCentiKnots(vel) / 100; // Convert to Knots
     }
     // Unreachable
     return -1;
@@ -393,33 +393,30 @@ static int32_t osdConvertVelocityToUnit(int32_t vel)
  */
 void osdFormatVelocityStr(char* buff, int32_t vel, bool _3D, bool _max)
 {
+    char sym;
     switch ((osd_unit_e)osdConfig()->units) {
     case OSD_UNIT_UK:
         FALLTHROUGH;
     case OSD_UNIT_METRIC_MPH:
         FALLTHROUGH;
     case OSD_UNIT_IMPERIAL:
-        if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_MPH : SYM_MPH));
-        } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_MPH : SYM_MPH));
-        }
-        break;
-    case OSD_UNIT_METRIC:
-        if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KMH : SYM_KMH));
-        } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KMH : SYM_KMH));
-        }
+        sym = _3D ? SYM_3D_MPH : SYM_MPH;
         break;
     case OSD_UNIT_GA:
-        if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KT : SYM_KT));
-        } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KT : SYM_KT));
-        }
+        sym = _3D ? SYM_3D_KT : SYM_KT;
         break;
+    default:
+    case OSD_UNIT_METRIC:
+        sym = _3D ? SYM_3D_KMH : SYM_KMH;
+        break;
+    }
+
+    if (_max) {
+        *buff++ = SYM_MAX;
     }
+    buff += osdFormatInteger(buff, osdConvertVelocityToUnit(vel), 3, ' ');
+    buff[0] = sym;
+    buff[1] = '\0';
 }
 
 /**
@@ -447,11 +444,11 @@ static void osdFormatWindSpeedStr(char *buff, int32_t ws, bool isValid)
         case OSD_UNIT_METRIC_MPH:
             FALLTHROUGH;
         case OSD_UNIT_IMPERIAL:
-            centivalue = CMSEC_TO_CENTIMPH(ws);
+            centivalue = osdCmsToCentiMph(ws);
             suffix = SYM_MPH;
             break;
         case OSD_UNIT_GA:
-            centivalue = CMSEC_TO_CENTIKNOTS(ws);
+            centivalue = osdCmsToCentiKnots(ws);
             suffix = SYM_KT;
             break;
         default:
@@ -463,7 +460,7 @@ static void osdFormatWindSpeedStr(char *buff, int32_t ws, bool isValid)
             }
             else
             {
-                centivalue = CMSEC_TO_CENTIKPH(ws);
+                centivalue = osdCmsToCentiKph(ws);
                 suffix = SYM_KMH;
             }
             break;
@@ -510,7 +507,7 @@ void osdFormatAltitudeSymbol(char *buff, int32_t alt)
         case OSD_UNIT_GA:
             FALLTHROUGH;
         case OSD_UNIT_IMPERIAL:
-            if (osdFormatCentiNumber(buff + totalDigits - digits, CENTIMETERS_TO_CENTIFEET(alt), 1000, 0, 2, digits, false)) {
+            if (osdFormatCentiNumber(buff + totalDigits - digits, osdCentimetersToCentifeet(alt), 1000, 0, 2, digits, false)) {
                 // Scaled to kft
                 buff[symbolIndex++] = symbolKFt;
             } else {
@@ -570,7 +567,9 @@ static void osdFormatTime(char *buff, uint32_t seconds, char sym_m, char sym_h)
         value = seconds / 60;
     }
     buff[0] = sym;
-    tfp_sprintf(buff + 1, "%02d:%02d", (int)(value / 60), (int)(value % 60));
+    buff += 1 + osdFormatInteger(buff + 1, value / 60, 2, '0');
+    *buff++ = ':';
+    osdFormatInteger(buff, value % 60, 2, '0');
 }
 
 static inline void osdFormatOnTime(char *buff)
@@ -2678,10 +2677,10 @@ static bool osdDrawSingleElement(uint8_t item)
                     case OSD_UNIT_UK:
                                 FALLTHROUGH;
                     case OSD_UNIT_IMPERIAL:
-                        osdFormatCentiNumber(buff, CENTIMETERS_TO_CENTIFEET(currentPeer->distance * 100), FEET_PER_MILE, 0, 4, 4, false);
+                        osdFormatCentiNumber(buff, osdCentimetersToCentifeet(currentPeer->distance * 100), FEET_PER_MILE, 0, 4, 4, false);
                         break;
                     case OSD_UNIT_GA:
-                        osdFormatCentiNumber(buff, CENTIMETERS_TO_CENTIFEET(currentPeer->distance * 100), (uint32_t)FEET_PER_NAUTICALMILE, 0, 4, 4, false);
+                        osdFormatCentiNumber(buff, osdCentimetersToCentifeet(currentPeer->distance * 100), (uint32_t)FEET_PER_NAUTICALMILE, 0, 4, 4, false);
                         break;
                     default:
                                 FALLTHROUGH;
@@ -2868,7 +2867,7 @@ static bool osdDrawSingleElement(uint8_t item)
                     FALLTHROUGH;
                 case OSD_UNIT_IMPERIAL:
                     // Convert to centifeet/s
-                    value = CENTIMETERS_TO_CENTIFEET(value);
+                    value = osdCentimetersToCentifeet(value);
                     sym = SYM_FTS;
                     break;
                 case OSD_UNIT_GA:
@@ -3957,6 +3956,183 @@ static bool osdDrawSingleElement(uint8_t item)
     return true;
 }
 
+/*
+ * Elements listed in osdElementSources[] are only formatted and written again when
+ * one of the data sources they display changed since they were last drawn. Everything
+ * else is redrawn on each pass, as before.
+ */
+#define OSD_ELEMENT_REFRESH_INTERVAL_MS 1000    // Redraw everything at least this often, in case something drew over an element
+
+typedef enum {
+    OSD_SOURCE_ATTITUDE,
+    OSD_SOURCE_VOLTAGE,
+    OSD_SOURCE_CURRENT,
+    OSD_SOURCE_CAPACITY,
+    OSD_SOURCE_ALTITUDE,
+    OSD_SOURCE_GPS,
+    OSD_SOURCE_RX,
+    OSD_SOURCE_TIME,
+    OSD_SOURCE_COUNT,
+    OSD_SOURCE_STATIC = OSD_SOURCE_COUNT,   // Only redrawn when the whole screen is invalidated
+} osdElementSource_e;
+
+#define OSD_DEPENDS_ON(source) (1 << (source))
+
+static const uint16_t osdElementSources[OSD_ITEM_COUNT] = {
+    [OSD_RSSI_VALUE]                                = OSD_DEPENDS_ON(OSD_SOURCE_RX),
+    [OSD_MAIN_BATT_VOLTAGE]                         = OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_SAG_COMPENSATED_MAIN_BATT_VOLTAGE]         = OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_MAIN_BATT_CELL_VOLTAGE]                    = OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_MAIN_BATT_SAG_COMPENSATED_CELL_VOLTAGE]    = OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_BATTERY_REMAINING_PERCENT]                 = OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_CURRENT_DRAW]                              = OSD_DEPENDS_ON(OSD_SOURCE_CURRENT),
+    [OSD_POWER]                                     = OSD_DEPENDS_ON(OSD_SOURCE_CURRENT),
+    [OSD_MAH_DRAWN]                                 = OSD_DEPENDS_ON(OSD_SOURCE_CAPACITY) | OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_WH_DRAWN]                                  = OSD_DEPENDS_ON(OSD_SOURCE_CAPACITY) | OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_BATTERY_REMAINING_CAPACITY]                = OSD_DEPENDS_ON(OSD_SOURCE_CAPACITY) | OSD_DEPENDS_ON(OSD_SOURCE_VOLTAGE),
+    [OSD_ALTITUDE]                                  = OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE),
+    [OSD_ALTITUDE_MSL]                              = OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE),
+    [OSD_VARIO]                                     = OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE),
+    [OSD_VARIO_NUM]                                 = OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE),
+    [OSD_ATTITUDE_ROLL]                             = OSD_DEPENDS_ON(OSD_SOURCE_ATTITUDE),
+    [OSD_ATTITUDE_PITCH]                            = OSD_DEPENDS_ON(OSD_SOURCE_ATTITUDE),
+    [OSD_HEADING]                                   = OSD_DEPENDS_ON(OSD_SOURCE_ATTITUDE),
+    [OSD_HEADING_GRAPH]                             = OSD_DEPENDS_ON(OSD_SOURCE_ATTITUDE),
+    [OSD_ARTIFICIAL_HORIZON]                        = OSD_DEPENDS_ON(OSD_SOURCE_ATTITUDE) | OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE) | OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_GPS_SATS]                                  = OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_GPS_SPEED]                                 = OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_3D_SPEED]                                  = OSD_DEPENDS_ON(OSD_SOURCE_GPS) | OSD_DEPENDS_ON(OSD_SOURCE_ALTITUDE),
+    [OSD_GPS_LAT]                                   = OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_GPS_LON]                                   = OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_GPS_HDOP]                                  = OSD_DEPENDS_ON(OSD_SOURCE_GPS),
+    [OSD_ONTIME]                                    = OSD_DEPENDS_ON(OSD_SOURCE_TIME),
+    [OSD_FLYTIME]                                   = OSD_DEPENDS_ON(OSD_SOURCE_TIME),
+    [OSD_ONTIME_FLYTIME]                            = OSD_DEPENDS_ON(OSD_SOURCE_TIME),
+    [OSD_CRAFT_NAME]                                = OSD_DEPENDS_ON(OSD_SOURCE_STATIC),
+    [OSD_PILOT_NAME]                                = OSD_DEPENDS_ON(OSD_SOURCE_STATIC),
+    [OSD_VERSION]                                   = OSD_DEPENDS_ON(OSD_SOURCE_STATIC),
+};
+
+static uint16_t osdFrameSeq;
+static uint16_t osdSourceChangedSeq[OSD_SOURCE_COUNT + 1];  // +1 for OSD_SOURCE_STATIC
+static uint32_t osdSourceSignature[OSD_SOURCE_COUNT];
+static uint16_t osdElementDrawnSeq[OSD_ITEM_COUNT];
+static timeMs_t osdElementsInvalidatedAt;
+static bool osdElementsInvalid = true;
+
+static uint32_t osdSignatureAdd(uint32_t signature, int32_t value)
+{
+    // FNV-1a over whole words, only needs to tell "same" from "different"
+    return (signature ^ (uint32_t)value) * 16777619U;
+}
+
+// Screen contents were lost, all elements are redrawn on the next pass
+static void osdInvalidateElements(void)
+{
+    osdElementsInvalid = true;
+}
+
+static void osdUpdateElementSources(void)
+{
+    uint32_t signature[OSD_SOURCE_COUNT];
+    const timeMs_t currentTimeMs = millis();
+
+    osdFrameSeq++;
+
+    if (osdElementsInvalid || currentTimeMs - osdElementsInvalidatedAt >= OSD_ELEMENT_REFRESH_INTERVAL_MS) {
+        for (int i = 0; i <= OSD_SOURCE_COUNT; i++) {
+            osdSourceChangedSeq[i] = osdFrameSeq;
+        }
+        osdElementsInvalidatedAt = currentTimeMs;
+        osdElementsInvalid = false;
+    }
+
+    for (int i = 0; i < OSD_SOURCE_COUNT; i++) {
+        signature[i] = 2166136261U;
+    }
+
+    signature[OSD_SOURCE_ATTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ATTITUDE], attitude.values.roll);
+    signature[OSD_SOURCE_ATTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ATTITUDE], attitude.values.pitch);
+    signature[OSD_SOURCE_ATTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ATTITUDE], attitude.values.yaw);
+    signature[OSD_SOURCE_ATTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ATTITUDE], osdIsHeadingValid());
+
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], getBatteryRawVoltage());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], getBatterySagCompensatedVoltage());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], getBatteryRawAverageCellVoltage());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], getBatterySagCompensatedAverageCellVoltage());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], calculateBatteryPercentage());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], getBatteryState());
+    signature[OSD_SOURCE_VOLTAGE] = osdSignatureAdd(signature[OSD_SOURCE_VOLTAGE], checkBatteryVoltageState());
+
+    signature[OSD_SOURCE_CURRENT] = osdSignatureAdd(signature[OSD_SOURCE_CURRENT], getAmperage());
+    signature[OSD_SOURCE_CURRENT] = osdSignatureAdd(signature[OSD_SOURCE_CURRENT], getPower());
+
+    signature[OSD_SOURCE_CAPACITY] = osdSignatureAdd(signature[OSD_SOURCE_CAPACITY], getMAhDrawn());
+    signature[OSD_SOURCE_CAPACITY] = osdSignatureAdd(signature[OSD_SOURCE_CAPACITY], getMWhDrawn());
+    signature[OSD_SOURCE_CAPACITY] = osdSignatureAdd(signature[OSD_SOURCE_CAPACITY], getBatteryRemainingCapacity());
+    signature[OSD_SOURCE_CAPACITY] = osdSignatureAdd(signature[OSD_SOURCE_CAPACITY], batteryWasFullWhenPluggedIn());
+
+    signature[OSD_SOURCE_ALTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ALTITUDE], getEstimatedActualPosition(Z));
+    signature[OSD_SOURCE_ALTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ALTITUDE], getEstimatedActualVelocity(Z));
+    signature[OSD_SOURCE_ALTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ALTITUDE], posControl.gpsOrigin.alt);
+    // Blinking altitude adjustment indicator on multirotors
+    signature[OSD_SOURCE_ALTITUDE] = osdSignatureAdd(signature[OSD_SOURCE_ALTITUDE], posControl.flags.isAdjustingAltitude ? 1 + OSD_ALTERNATING_CHOICES(600, 2) : 0);
+
+#ifdef USE_GPS
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], gpsSol.numSat);
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], gpsSol.hdop);
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], gpsSol.groundSpeed);
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], gpsSol.llh.lat);
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], gpsSol.llh.lon);
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], getHwGPSStatus());
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], STATE(GPS_FIX));
+#ifdef USE_GPS_FIX_ESTIMATION
+    signature[OSD_SOURCE_GPS] = osdSignatureAdd(signature[OSD_SOURCE_GPS], STATE(GPS_ESTIMATED_FIX));
+#endif
+#endif
+
+    signature[OSD_SOURCE_RX] = osdSignatureAdd(signature[OSD_SOURCE_RX], osdConvertRSSI());
+
+    signature[OSD_SOURCE_TIME] = osdSignatureAdd(signature[OSD_SOURCE_TIME], micros() / 1000000);
+    signature[OSD_SOURCE_TIME] = osdSignatureAdd(signature[OSD_SOURCE_TIME], getFlightTime());
+    signature[OSD_SOURCE_TIME] = osdSignatureAdd(signature[OSD_SOURCE_TIME], ARMING_FLAG(ARMED));
+
+    for (int i = 0; i < OSD_SOURCE_COUNT; i++) {
+        if (signature[i] != osdSourceSignature[i]) {
+            osdSourceSignature[i] = signature[i];
+            osdSourceChangedSeq[i] = osdFrameSeq;
+        }
+    }
+}
+
+static bool osdElementNeedsRedraw(uint8_t item)
+{
+    const uint16_t sources = osdElementSources[item];
+
+    if (!sources) {
+        return true;
+    }
+
+    for (int i = 0; i <= OSD_SOURCE_COUNT; i++) {
+        if ((sources & OSD_DEPENDS_ON(i)) && (int16_t)(osdSourceChangedSeq[i] - osdElementDrawnSeq[item]) >= 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool osdDrawElementIfChanged(uint8_t item)
+{
+    if (!osdElementNeedsRedraw(item)) {
+        return false;
+    }
+
+    // Marked even if not drawn, keeps the sequence of invisible elements from wrapping around
+    osdElementDrawnSeq[item] = osdFrameSeq + 1;
+    return osdDrawSingleElement(item);
+}
+
 uint8_t osdIncElementIndex(uint8_t elementIndex)
 {
     ++elementIndex;
@@ -4071,10 +4247,10 @@ void osdDrawNextElement(void)
     uint8_t index = elementIndex;
     do {
         elementIndex = osdIncElementIndex(elementIndex);
-    } while (!osdDrawSingleElement(elementIndex) && index != elementIndex);
+    } while (!osdDrawElementIfChanged(elementIndex) && index != elementIndex);
 
     // Draw artificial horizon + tracking telemetry last
-    osdDrawSingleElement(OSD_ARTIFICIAL_HORIZON);
+    osdDrawElementIfChanged(OSD_ARTIFICIAL_HORIZON);
     if (osdConfig()->telemetry>0){
         osdDisplayTelemetry();
     }
@@ -5681,6 +5857,7 @@ static void osdRefresh(timeUs_t currentTimeUs)
     if (IS_RC_MODE_ACTIVE(BOXOSD) && !(osdConfig()->osd_failsafe_switch_layout && FLIGHT_MODE(FAILSAFE_MODE))) {
 #endif
       displayClearScreen(osdDisplayPort);
+      osdInvalidateElements();
       armState = ARMING_FLAG(ARMED);
       return;
     }
@@ -5785,6 +5962,7 @@ static void osdRefresh(timeUs_t currentTimeUs)
             // Time elapsed or canceled by stick commands.
             // Exit to normal OSD operation.
             displayClearScreen(osdDisplayPort);
+            osdInvalidateElements();
             resumeRefreshAt = 0;
             statsDisplayed = false;
         } else {
@@ -5801,13 +5979,17 @@ static void osdRefresh(timeUs_t currentTimeUs)
         displayBeginTransaction(osdDisplayPort, DISPLAY_TRANSACTION_OPT_RESET_DRAWING);
         if (fullRedraw) {
             displayClearScreen(osdDisplayPort);
+            osdInvalidateElements();
             fullRedraw = false;
         }
+        osdUpdateElementSources();
         osdDrawNextElement();
         displayHeartbeat(osdDisplayPort);
         displayCommitTransaction(osdDisplayPort);
-#ifdef OSD_CALLS_CMS
     } else {
+        // CMS is using the screen, everything has to be drawn again once it's released
+        osdInvalidateElements();
+#ifdef OSD_CALLS_CMS
         cmsUpdate(currentTimeUs);
 #endif
     }
@@ -37,6 +37,58 @@ int digitCount(int32_t value)
     return digits;
 }
 
+int osdFormatInteger(char *buff, int32_t value, int width, char pad)
+{
+    char digits[10];
+    int digitsCount = 0;
+    uint32_t absValue = value < 0 ? -(uint32_t)value : (uint32_t)value;
+    char *ptr = buff;
+
+    do {
+        digits[digitsCount++] = '0' + absValue % 10;
+        absValue /= 10;
+    } while (absValue);
+
+    int padding = width - digitsCount - (value < 0 ? 1 : 0);
+    if (value < 0 && pad == '0') {
+        *ptr++ = '-';
+    }
+    while (padding-- > 0) {
+        *ptr++ = pad;
+    }
+    if (value < 0 && pad != '0') {
+        *ptr++ = '-';
+    }
+    while (digitsCount) {
+        *ptr++ = digits[--digitsCount];
+    }
+    *ptr = '\0';
+
+    return ptr - buff;
+}
+
+int32_t osdCentimetersToCentifeet(int32_t cm)
+{
+    // 1ft = 30.48cm = 381/12.5cm, split to stay within 32 bits
+    return (cm / 381) * 1250 + (cm % 381) * 1250 / 381;
+}
+
+int32_t osdCmsToCentiKph(int32_t cms)
+{
+    return cms * 36 / 10;
+}
+
+int32_t osdCmsToCentiMph(int32_t cms)
+{
+    // 1mph = 44.704cm/s
+    return cms * 3125 / 1397;
+}
+
+int32_t osdCmsToCentiKnots(int32_t cms)
+{
+    // 1kt = 1852m/h
+    return cms * 900 / 463;
+}
 
 bool osdFormatCentiNumber(char *buff, int32_t centivalue, uint32_t scale, int maxDecimals, int maxScaledDecimals, int length, bool leadingZeros)
 {
@@ -35,4 +35,20 @@ int digitCount(int32_t value);
  */
 bool osdFormatCentiNumber(char *buff, int32_t centivalue, uint32_t scale, int maxDecimals, int maxScaledDecimals, int length, bool leadingZeros);
 
+/**
+ * Formats an integer right aligned to at least width characters, padded
+ * with pad, like "%*d" or "%0*d". Returns the number of characters written.
+ */
+int osdFormatInteger(char *buff, int32_t value, int width, char pad);
+
+/**
+ * Unit conversions for display, in integer math. Results are truncated
+ * towards zero like the float CENTIMETERS_TO_CENTIFEET() and CMSEC_TO_*()
+ * macros.
+ */
+int32_t osdCentimetersToCentifeet(int32_t cm);
+int32_t osdCmsToCentiKph(int32_t cms);
+int32_t osdCmsToCentiMph(int32_t cms);
+int32_t osdCmsToCentiKnots(int32_t cms);
+
 #endif
@@ -36,4 +36,7 @@
 #define MSP2_COMMON_SET_MSP_RC_LINK_STATS   0x100D //in message        Sets the MSP RC stats
 #define MSP2_COMMON_SET_MSP_RC_INFO         0x100E //in message        Sets the MSP RC info
 
+#define MSP2_COMMON_SETTINGS_BATCH          0x100F //in/out message    Returns the values for a range of settings or a whole PG
+#define MSP2_COMMON_SET_SETTINGS_BATCH      0x1010 //in/out message    Validates and sets a list of settings by index
+
 #define MSP2_BETAFLIGHT_BIND                0x3000
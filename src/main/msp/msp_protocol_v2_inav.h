@@ -91,6 +91,11 @@
 #define MSP2_INAV_ESC_RPM                       0x2040
 #define MSP2_INAV_ESC_TELEM                     0x2041
 
+#define MSP2_INAV_WP_BATCH                      0x2042
+#define MSP2_INAV_SET_WP_BATCH                  0x2043
+
+#define MSP2_INAV_RX_FRAME_TIMING               0x2044
+
 #define MSP2_INAV_LED_STRIP_CONFIG_EX           0x2048
 #define MSP2_INAV_SET_LED_STRIP_CONFIG_EX       0x2049
 
@@ -3869,7 +3869,7 @@ void getWaypoint(uint8_t wpNumber, navWaypoint_t * wpData)
     }
 }
 
-void setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData)
+bool setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData)
 {
     gpsLocation_t wpLLH;
     navWaypointPosition_t wpPos;
@@ -3884,6 +3884,7 @@ void setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData)
         // Forcibly set home position. Note that this is only valid if already armed, otherwise home will be reset instantly
         geoConvertGeodeticToLocal(&wpPos.pos, &posControl.gpsOrigin, &wpLLH, GEO_ALT_RELATIVE);
         setHomePosition(&wpPos.pos, 0, NAV_POS_UPDATE_XY | NAV_POS_UPDATE_Z | NAV_POS_UPDATE_HEADING, NAV_HOME_VALID_ALL);
+        return true;
     }
     // WP #255 - special waypoint - directly set desiredPosition
     // Only valid when armed and in poshold mode
@@ -3905,6 +3906,7 @@ void setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData)
         }
 
         setDesiredPosition(&wpPos.pos, DEGREES_TO_CENTIDEGREES(wpData->p1), waypointUpdateFlags);
+        return true;
     }
     // WP #1 - #NAV_MAX_WAYPOINTS - common waypoints - pre-programmed mission
     else if ((wpNumber >= 1) && (wpNumber <= NAV_MAX_WAYPOINTS) && !FLIGHT_MODE(NAV_WP_MODE)) {
@@ -3935,9 +3937,12 @@ void setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData)
                         posControl.activeWaypointIndex = 0;
                     }
                 }
+                return true;
             }
         }
     }
+
+    return false;
 }
 
 void resetWaypointList(void)
@@ -354,6 +354,7 @@ typedef struct positionEstimationConfig_s {
     uint8_t allow_dead_reckoning;
 
     uint16_t max_surface_altitude;
+    uint16_t gps_delay_ms;                  // GPS measurement latency compensated by the estimator (ms)
 
     float w_z_baro_p;           // Weight (cutoff frequency) for barometer altitude measurements
     float w_z_baro_v;           // Weight (cutoff frequency) for barometer climb rate measurements
@@ -705,7 +706,7 @@ void getEstimatedPositionAndVelocity(navPositionAndVelocity_t * pos);
 int getWaypointCount(void);
 bool isWaypointListValid(void);
 void getWaypoint(uint8_t wpNumber, navWaypoint_t * wpData);
-void setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData);
+bool setWaypoint(uint8_t wpNumber, const navWaypoint_t * wpData);
 void resetWaypointList(void);
 bool loadNonVolatileWaypointList(bool clearIfLoaded);
 bool saveNonVolatileWaypointList(void);
@@ -56,7 +56,9 @@
 navigationPosEstimator_t posEstimator;
 static float initialBaroAltitudeOffset = 0.0f;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig, PG_POSITION_ESTIMATION_CONFIG, 8);
+STATIC_ASSERT(INAV_GPS_DELAY_MAX_MS == SETTING_INAV_GPS_DELAY_MAX, gps_delay_history_size_mismatch);
+
+PG_REGISTER_WITH_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig, PG_POSITION_ESTIMATION_CONFIG, 9);
 
 PG_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig,
         // Inertial position estimator parameters
@@ -67,6 +69,7 @@ PG_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig,
         .allow_dead_reckoning = SETTING_INAV_ALLOW_DEAD_RECKONING_DEFAULT,
 
         .max_surface_altitude = SETTING_INAV_MAX_SURFACE_ALTITUDE_DEFAULT,
+        .gps_delay_ms = SETTING_INAV_GPS_DELAY_DEFAULT,
 
         .w_z_baro_p = SETTING_INAV_W_Z_BARO_P_DEFAULT,
         .w_z_baro_v = SETTING_INAV_W_Z_BARO_V_DEFAULT,
@@ -519,6 +522,74 @@ static uint32_t calculateCurrentValidityFlags(timeUs_t currentTimeUs)
     return newFlags;
 }
 
+/**
+ * Keep a short history of past estimates so measurements with significant latency (GPS)
+ * are compared against the state the vehicle was in when the measurement was taken
+ */
+static void estimationStoreHistory(timeUs_t currentTimeUs)
+{
+    navPositionEstimatorHISTORY_t * const history = &posEstimator.history;
+
+    if (positionEstimationConfig()->gps_delay_ms == 0) {
+        history->count = 0;
+        return;
+    }
+
+    if ((currentTimeUs - history->lastUpdateTime) < HZ2US(INAV_HISTORY_RATE_HZ)) {
+        return;
+    }
+
+    history->lastUpdateTime = currentTimeUs;
+    history->index = (history->index + 1) % INAV_HISTORY_SIZE;
+    history->pos[history->index] = posEstimator.est.pos;
+    history->vel[history->index] = posEstimator.est.vel;
+
+    if (history->count < INAV_HISTORY_SIZE) {
+        history->count++;
+    }
+}
+
+/* Corrections move the whole past trajectory, otherwise a single GPS update would be applied again on the next one */
+static void estimationShiftHistory(const fpVector3_t * posCorr, const fpVector3_t * velCorr)
+{
+    navPositionEstimatorHISTORY_t * const history = &posEstimator.history;
+
+    for (int i = 0; i < history->count; i++) {
+        const int idx = (history->index + INAV_HISTORY_SIZE - i) % INAV_HISTORY_SIZE;
+        vectorAdd(&history->pos[idx], &history->pos[idx], posCorr);
+        vectorAdd(&history->vel[idx], &history->vel[idx], velCorr);
+    }
+}
+
+/* Returns the estimate from when the latest GPS sample was taken: its age since it arrived plus receiver latency */
+static void estimationGetDelayedGpsState(const estimationContext_t * ctx, const fpVector3_t ** pos, const fpVector3_t ** vel)
+{
+    navPositionEstimatorHISTORY_t * const history = &posEstimator.history;
+
+    if (history->count == 0) {
+        *pos = &posEstimator.est.pos;
+        *vel = &posEstimator.est.vel;
+        return;
+    }
+
+    const timeDelta_t delayUs = MAX(0, cmpTimeUs(ctx->currentTimeUs, posEstimator.gps.lastUpdateTime)) + MS2US(positionEstimationConfig()->gps_delay_ms);
+    const int wantedSamples = (delayUs + HZ2US(INAV_HISTORY_RATE_HZ) / 2) / HZ2US(INAV_HISTORY_RATE_HZ);
+    const int delaySamples = MIN(wantedSamples, history->count - 1);
+
+    // The history covers the max gps_delay plus one period of the slowest GPS, so this only
+    // happens when GPS updates are late or missing. The oldest sample is the best we have then.
+    const bool delayClamped = wantedSamples >= INAV_HISTORY_SIZE;
+    if (delayClamped && !history->delayClamped) {
+        LOG_WARNING(POS_ESTIMATOR, "GPS delay %dms exceeds estimate history", (int)US2MS(delayUs));
+    }
+    history->delayClamped = delayClamped;
+
+    const int idx = (history->index + INAV_HISTORY_SIZE - delaySamples) % INAV_HISTORY_SIZE;
+
+    *pos = &history->pos[idx];
+    *vel = &history->vel[idx];
+}
+
 static void estimationPredict(estimationContext_t * ctx)
 {
 
@@ -629,9 +700,13 @@ static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
             ctx->newEPV = posEstimator.gps.epv;
         }
         else {
+            const fpVector3_t * delayedPos;
+            const fpVector3_t * delayedVel;
+            estimationGetDelayedGpsState(ctx, &delayedPos, &delayedVel);
+
             // Altitude
-            const float gpsAltResidual = wGps * (posEstimator.gps.pos.z - posEstimator.est.pos.z);
-            const float gpsVelZResidual = wGps * (posEstimator.gps.vel.z - posEstimator.est.vel.z);
+            const float gpsAltResidual = wGps * (posEstimator.gps.pos.z - delayedPos->z);
+            const float gpsVelZResidual = wGps * (posEstimator.gps.vel.z - delayedVel->z);
             const float w_z_gps_p = positionEstimationConfig()->w_z_gps_p;
 
             ctx->estPosCorr.z += gpsAltResidual * w_z_gps_p * ctx->dt;
@@ -661,10 +736,14 @@ static bool estimationCalculateCorrection_XY_GPS(estimationContext_t * ctx)
             ctx->newEPH = posEstimator.gps.eph;
         }
         else {
-            const float gpsPosXResidual = posEstimator.gps.pos.x - posEstimator.est.pos.x;
-            const float gpsPosYResidual = posEstimator.gps.pos.y - posEstimator.est.pos.y;
-            const float gpsVelXResidual = posEstimator.gps.vel.x - posEstimator.est.vel.x;
-            const float gpsVelYResidual = posEstimator.gps.vel.y - posEstimator.est.vel.y;
+            const fpVector3_t * delayedPos;
+            const fpVector3_t * delayedVel;
+            estimationGetDelayedGpsState(ctx, &delayedPos, &delayedVel);
+
+            const float gpsPosXResidual = posEstimator.gps.pos.x - delayedPos->x;
+            const float gpsPosYResidual = posEstimator.gps.pos.y - delayedPos->y;
+            const float gpsVelXResidual = posEstimator.gps.vel.x - delayedVel->x;
+            const float gpsVelYResidual = posEstimator.gps.vel.y - delayedVel->y;
             const float gpsPosResidualMag = calc_length_pythagorean_2D(gpsPosXResidual, gpsPosYResidual);
 
             //const float gpsWeightScaler = scaleRangef(bellCurve(gpsPosResidualMag, INAV_GPS_ACCEPTANCE_EPE), 0.0f, 1.0f, 0.1f, 1.0f);
@@ -723,6 +802,7 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     const float max_eph_epv = positionEstimationConfig()->max_eph_epv;
 
     /* Calculate dT */
+    ctx.currentTimeUs = currentTimeUs;
     ctx.dt = US2S(currentTimeUs - posEstimator.est.lastUpdateTime);
     posEstimator.est.lastUpdateTime = currentTimeUs;
 
@@ -731,6 +811,7 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
         posEstimator.est.eph = max_eph_epv + 0.001f;
         posEstimator.est.epv = max_eph_epv + 0.001f;
         posEstimator.flags = 0;
+        posEstimator.history.count = 0;
         return;
     }
 
@@ -774,6 +855,8 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     // Apply corrections
     vectorAdd(&posEstimator.est.pos, &posEstimator.est.pos, &ctx.estPosCorr);
     vectorAdd(&posEstimator.est.vel, &posEstimator.est.vel, &ctx.estVelCorr);
+    estimationShiftHistory(&ctx.estPosCorr, &ctx.estVelCorr);
+    estimationStoreHistory(currentTimeUs);
 
     /* Correct accelerometer bias */
     const float w_acc_bias = positionEstimationConfig()->w_acc_bias;
@@ -891,6 +974,8 @@ void initializePositionEstimator(void)
 
     posEstimator.imu.accWeightFactor = 0;
 
+    posEstimator.history.count = 0;
+
     restartGravityCalibration();
 
     for (axis = 0; axis < 3; axis++) {
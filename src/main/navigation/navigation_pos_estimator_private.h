@@ -38,6 +38,11 @@
 #define INAV_GPS_GLITCH_ACCEL               1000.0f // 10m/s/s max possible acceleration for GPS glitch detection
 
 #define INAV_POSITION_PUBLISH_RATE_HZ       50      // Publish position updates at this rate
+#define INAV_HISTORY_RATE_HZ                50      // Store past estimates at this rate for latency compensation
+#define INAV_GPS_DELAY_MAX_MS               300     // Max of inav_gps_delay
+#define INAV_GPS_PERIOD_MAX_MS              200     // Slowest GPS update rate, 5Hz
+// Holds the max GPS delay plus the age of a GPS sample just before the next one arrives, 26 entries = 500ms
+#define INAV_HISTORY_SIZE                   ((INAV_GPS_DELAY_MAX_MS + INAV_GPS_PERIOD_MAX_MS) * INAV_HISTORY_RATE_HZ / 1000 + 1)
 #define INAV_PITOT_UPDATE_RATE              10
 
 #define INAV_GPS_TIMEOUT_MS                 1500    // GPS timeout
@@ -127,6 +132,15 @@ typedef struct {
     int16_t     cog;    // course over ground (decidegrees)
 } navPositionEstimatorESTIMATE_t;
 
+typedef struct {
+    timeUs_t    lastUpdateTime; // Last time a sample was stored (us)
+    fpVector3_t pos[INAV_HISTORY_SIZE];
+    fpVector3_t vel[INAV_HISTORY_SIZE];
+    uint8_t     index;          // Slot holding the newest sample
+    uint8_t     count;          // Number of valid samples
+    bool        delayClamped;   // Last lookup reached further back than the history holds
+} navPositionEstimatorHISTORY_t;
+
 typedef struct {
      timeUs_t               lastUpdateTime;
     fpVector3_t             accelNEU;
@@ -176,11 +190,15 @@ typedef struct {
     // Estimate
     navPositionEstimatorESTIMATE_t  est;
 
+    // Past estimates, used to fuse delayed measurements
+    navPositionEstimatorHISTORY_t   history;
+
     // Extra state variables
     navPositionEstimatorSTATE_t state;
 } navigationPosEstimator_t;
 
 typedef struct {
+    timeUs_t currentTimeUs;
     float dt;
     uint32_t newFlags;
     float newEPV;
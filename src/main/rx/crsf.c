@@ -56,6 +56,7 @@ STATIC_UNIT_TESTED uint32_t crsfChannelData[CRSF_MAX_CHANNEL];
 
 static serialPort_t *serialPort;
 static timeUs_t crsfFrameStartAt = 0;
+static timeUs_t crsfRcFrameTimeUs = 0;
 static uint8_t telemetryBuf[CRSF_FRAME_SIZE_MAX];
 static uint8_t telemetryBufLen = 0;
 
@@ -127,12 +128,8 @@ typedef struct crsfPayloadLinkStatistics_s crsfPayloadLinkStatistics_t;
 
 STATIC_UNIT_TESTED uint8_t crsfFrameCRC(void)
 {
-    // CRC includes type and payload
-    uint8_t crc = crc8_dvb_s2(0, crsfFrame.frame.type);
-    for (int ii = 0; ii < crsfFrame.frame.frameLength - CRSF_FRAME_LENGTH_TYPE_CRC; ++ii) {
-        crc = crc8_dvb_s2(crc, crsfFrame.frame.payload[ii]);
-    }
-    return crc;
+    // CRC includes type and payload, which are contiguous in the frame
+    return crc8_dvb_s2_update(0, &crsfFrame.frame.type, crsfFrame.frame.frameLength - CRSF_FRAME_LENGTH_CRC);
 }
 
 // Receive ISR callback, called back from serial port
@@ -160,12 +157,21 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *rxCallbackData)
     // full frame length includes the length of the address and framelength fields
     const int fullFrameLength = crsfFramePosition < 3 ? 5 : crsfFrame.frame.frameLength + CRSF_FRAME_LENGTH_ADDRESS + CRSF_FRAME_LENGTH_FRAMELENGTH;
 
+    if (fullFrameLength > CRSF_FRAME_SIZE_MAX) {
+        // Corrupted length, resync instead of waiting for (and writing
+        // past the end of the buffer with) a frame that can't be valid
+        crsfFramePosition = 0;
+        return;
+    }
+
     if (crsfFramePosition < fullFrameLength) {
         crsfFrame.bytes[crsfFramePosition++] = (uint8_t)c;
         crsfFrameDone = crsfFramePosition < fullFrameLength ? false : true;
         if (crsfFrameDone) {
             crsfFramePosition = 0;
-            if (crsfFrame.frame.type != CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
+            if (crsfFrame.frame.type == CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
+                crsfRcFrameTimeUs = now;
+            } else {
                 const uint8_t crc = crsfFrameCRC();
                 if (crc == crsfFrame.bytes[fullFrameLength - 1]) {
                     switch (crsfFrame.frame.type)
@@ -282,6 +288,11 @@ void crsfRxWriteTelemetryData(const void *data, int len)
     telemetryBufLen = len;
 }
 
+bool crsfRxIsTelemetryBufEmpty(void)
+{
+    return telemetryBufLen == 0;
+}
+
 void crsfRxSendTelemetryData(void)
 {
     // if there is telemetry data to write
@@ -300,6 +311,11 @@ void crsfRxSendTelemetryData(void)
     }
 }
 
+static timeUs_t crsfFrameTimeUs(void)
+{
+    return crsfRcFrameTimeUs;
+}
+
 bool crsfRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
 {
     for (int ii = 0; ii < CRSF_MAX_CHANNEL; ++ii) {
@@ -309,6 +325,7 @@ bool crsfRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->channelCount = CRSF_MAX_CHANNEL;
     rxRuntimeConfig->rcReadRawFn = crsfReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = crsfFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = crsfFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
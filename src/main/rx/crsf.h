@@ -128,6 +128,7 @@ typedef union crsfFrame_u {
 
 void crsfRxWriteTelemetryData(const void *data, int len);
 void crsfRxSendTelemetryData(void);
+bool crsfRxIsTelemetryBufEmpty(void);
 
 struct rxConfig_s;
 struct rxRuntimeConfig_s;
@@ -130,6 +130,7 @@ static const smartPortPayload_t emptySmartPortFrame = { .frameId = 0, .valueId =
 typedef struct fportBuffer_s {
     uint8_t data[BUFFER_SIZE];
     uint8_t length;
+    timeUs_t frameTimeUs;
 } fportBuffer_t;
 
 static fportBuffer_t rxBuffer[NUM_RX_BUFFERS];
@@ -144,6 +145,7 @@ static volatile uint8_t framePosition = 0;
 
 static smartPortPayload_t *mspPayload = NULL;
 static timeUs_t lastRcFrameReceivedMs = 0;
+static timeUs_t lastRcFrameTimeUs = 0;
 
 static serialPort_t *fportPort;
 
@@ -179,6 +181,7 @@ static void fportDataReceive(uint16_t c, void *data)
             const uint8_t nextWriteIndex = (rxBufferWriteIndex + 1) % NUM_RX_BUFFERS;
             if (nextWriteIndex != rxBufferReadIndex) {
                 rxBuffer[rxBufferWriteIndex].length = framePosition - 1;
+                rxBuffer[rxBufferWriteIndex].frameTimeUs = currentTimeUs;
                 rxBufferWriteIndex = nextWriteIndex;
             }
 
@@ -229,6 +232,11 @@ static void smartPortWriteFrameFport(const smartPortPayload_t *payload)
 }
 #endif
 
+static timeUs_t fportFrameTimeUs(void)
+{
+    return lastRcFrameTimeUs;
+}
+
 static uint8_t fportFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 {
 #if defined(USE_TELEMETRY_SMARTPORT)
@@ -259,6 +267,7 @@ static uint8_t fportFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
                         result = sbusChannelsDecode(rxRuntimeConfig, &frame->data.controlData.channels);
                         lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(frame->data.controlData.rssi, 0, 100, 0, RSSI_MAX_VALUE));
                         lastRcFrameReceivedMs = millis();
+                        lastRcFrameTimeUs = rxBuffer[rxBufferReadIndex].frameTimeUs;
                     }
 
                     break;
@@ -367,6 +376,7 @@ bool fportRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
 
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
     rxRuntimeConfig->rcFrameStatusFn = fportFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = fportFrameTimeUs;
     rxRuntimeConfig->rcProcessFrameFn = fportProcessFrame;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
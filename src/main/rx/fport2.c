@@ -158,6 +158,7 @@ typedef struct {
 typedef struct fportBuffer_s {
     uint8_t data[sizeof(fportFrame_t)+1]; // +1 for CRC
     uint8_t length;
+    timeUs_t frameTimeUs;
 } fportBuffer_t;
 
 typedef struct {
@@ -170,6 +171,7 @@ static volatile uint8_t rxBufferWriteIndex = 0;
 static volatile uint8_t rxBufferReadIndex = 0;
 
 static serialPort_t *fportPort;
+static timeUs_t lastRcFrameTimeUs = 0;
 
 #ifdef USE_TELEMETRY_SMARTPORT
 static smartPortPayload_t *mspPayload = NULL;
@@ -271,6 +273,7 @@ static void fportDataReceive(uint16_t byte, void *callback_data)
 
         case FS_CONTROL_FRAME_DATA: {
             if (writeBuffer(byte) > controlFrameSize) {
+                rxBuffer[rxBufferWriteIndex].frameTimeUs = currentTimeUs;
                 nextWriteBuffer();
                 state = FS_DOWNLINK_FRAME_START;
             }
@@ -329,6 +332,11 @@ static void writeUplinkFrame(const smartPortPayload_t *payload)
 }
 #endif
 
+static timeUs_t frameTimeUs(void)
+{
+    return lastRcFrameTimeUs;
+}
+
 static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 {
 #ifdef USE_TELEMETRY_SMARTPORT
@@ -363,6 +371,7 @@ static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
                             result = sbusChannelsDecode(rxRuntimeConfig, &frame->control.rc.channels);
                             lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(frame->control.rc.rssi, 0, 100, 0, RSSI_MAX_VALUE));
                             frameReceivedTimestamp = currentTimeUs;
+                            lastRcFrameTimeUs = rxBuffer[rxBufferReadIndex].frameTimeUs;
 #if defined(USE_TELEMETRY_SMARTPORT)
                             otaMode = false;
 #endif
@@ -638,6 +647,7 @@ bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig
 
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
     rxRuntimeConfig->rcFrameStatusFn = frameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = frameTimeUs;
     rxRuntimeConfig->rcProcessFrameFn = processFrame;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
@@ -237,6 +237,12 @@ static bool ghstDetectFailsafe(void)
     return false;
 }
 
+static timeUs_t ghstFrameTimeUs(void)
+{
+    // ghstValidatedFrame is updated together with the frame end time
+    return ghstRxFrameEndAtUs;
+}
+
 uint8_t ghstFrameStatus(rxRuntimeConfig_t *rxRuntimeState)
 {
     UNUSED(rxRuntimeState);
@@ -349,6 +355,7 @@ bool ghstRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeState)
     rxRuntimeState->channelCount = GHST_MAX_NUM_CHANNELS;
     rxRuntimeState->rcReadRawFn = ghstReadRawRC;
     rxRuntimeState->rcFrameStatusFn = ghstFrameStatus;
+    rxRuntimeState->rcFrameTimeUsFn = ghstFrameTimeUs;
     rxRuntimeState->rcProcessFrameFn = ghstProcessFrame;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
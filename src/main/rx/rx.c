@@ -90,6 +90,8 @@ static uint8_t rxChannelCount;
 
 static timeUs_t rxNextUpdateAtUs = 0;
 static timeUs_t needRxSignalBefore = 0;
+static rxFrameTiming_t rxFrameTiming;
+static timeDelta_t rxFrameIntervalAvgUs;
 static bool isRxSuspended = false;
 
 static rcChannel_t rcChannels[MAX_SUPPORTED_RC_CHANNEL_COUNT];
@@ -98,7 +100,7 @@ rxLinkStatistics_t rxLinkStatistics;
 rxRuntimeConfig_t rxRuntimeConfig;
 static uint8_t rcSampleIndex = 0;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 12);
+PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 13);
 
 #ifndef SERIALRX_PROVIDER
 #define SERIALRX_PROVIDER 0
@@ -133,6 +135,7 @@ PG_RESET_TEMPLATE(rxConfig_t, rxConfig,
     .mspOverrideChannels = SETTING_MSP_OVERRIDE_CHANNELS_DEFAULT,
 #endif
     .rssi_source = SETTING_RSSI_SOURCE_DEFAULT,
+    .pidSync = SETTING_RX_PID_SYNC_DEFAULT,
 #ifdef USE_SERIALRX_SRXL2
     .srxl2_unit_id = SETTING_SRXL2_UNIT_ID_DEFAULT,
     .srxl2_baud_fast = SETTING_SRXL2_BAUD_FAST_DEFAULT,
@@ -262,6 +265,7 @@ void rxInit(void)
     rxRuntimeConfig.lqTracker = &rxLQTracker;
     rxRuntimeConfig.rcReadRawFn = nullReadRawRC;
     rxRuntimeConfig.rcFrameStatusFn = nullFrameStatus;
+    rxRuntimeConfig.rcFrameTimeUsFn = NULL;
     rxRuntimeConfig.rxSignalTimeout = DELAY_10_HZ;
     rcSampleIndex = 0;
 
@@ -396,6 +400,40 @@ void resumeRxSignal(void)
     failsafeOnRxResume();
 }
 
+static void rxUpdateFrameTiming(timeUs_t currentTimeUs)
+{
+    // Prefer the time the frame arrived on the wire, as captured by the
+    // driver in the RX ISR, so scheduling jitter doesn't leak in.
+    const timeUs_t frameTimeUs = rxRuntimeConfig.rcFrameTimeUsFn ? rxRuntimeConfig.rcFrameTimeUsFn() : currentTimeUs;
+
+    if (rxFrameTiming.lastFrameTimeUs != 0) {
+        const timeDelta_t intervalUs = cmpTimeUs(frameTimeUs, rxFrameTiming.lastFrameTimeUs);
+        if (intervalUs <= 0) {
+            // Driver reported the same frame again
+            return;
+        }
+        // Don't let link dropouts skew the average and jitter
+        if (intervalUs < (timeDelta_t)rxRuntimeConfig.rxSignalTimeout) {
+            rxFrameTiming.intervalUs = intervalUs;
+            if (rxFrameIntervalAvgUs == 0) {
+                rxFrameIntervalAvgUs = intervalUs;
+            } else {
+                rxFrameIntervalAvgUs += (intervalUs - rxFrameIntervalAvgUs) / 8;
+            }
+            const int32_t deviation = ABS(intervalUs - rxFrameIntervalAvgUs);
+            rxFrameTiming.jitterUs = constrain(rxFrameTiming.jitterUs + (deviation - rxFrameTiming.jitterUs) / 8, 0, UINT16_MAX);
+        }
+    }
+
+    rxFrameTiming.latencyUs = cmpTimeUs(currentTimeUs, frameTimeUs);
+    rxFrameTiming.lastFrameTimeUs = frameTimeUs;
+}
+
+const rxFrameTiming_t *rxGetFrameTiming(void)
+{
+    return &rxFrameTiming;
+}
+
 bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
 {
     UNUSED(currentDeltaTime);
@@ -413,6 +451,7 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
         rxSignalReceived = (frameStatus & RX_FRAME_FAILSAFE) == 0;
         needRxSignalBefore = currentTimeUs + rxRuntimeConfig.rxSignalTimeout;
         rxDataProcessingRequired = true;
+        rxUpdateFrameTiming(currentTimeUs);
     }
     else if ((frameStatus & RX_FRAME_FAILSAFE) && rxSignalReceived) {
         // All other receiver statuses are allowed to report failsafe, but not allowed to leave it
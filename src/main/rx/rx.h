@@ -128,6 +128,7 @@ typedef struct rxConfig_s {
     uint8_t autoSmoothFactor;               // auto smooth rx input factor (1 = no smoothing, 100 = lots of smoothing)
     uint16_t mspOverrideChannels;           // Channels to override with MSP RC when BOXMSPRCOVERRIDE is active
     uint8_t rssi_source;
+    uint8_t pidSync;                        // Check for and process new RX frames from the PID loop (0 = off, 1 = on)
 #ifdef USE_SERIALRX_SRXL2
     uint8_t srxl2_unit_id;
     uint8_t srxl2_baud_fast;
@@ -153,6 +154,7 @@ typedef uint16_t (*rcReadRawDataFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig,
 typedef uint8_t (*rcFrameStatusFnPtr)(rxRuntimeConfig_t *rxRuntimeConfig);
 typedef bool (*rcProcessFrameFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
 typedef uint16_t (*rcGetLinkQualityPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
+typedef timeUs_t (*rcFrameTimeUsFnPtr)(void);
 
 typedef struct rxRuntimeConfig_s {
     uint8_t channelCount;                  // number of rc channels as reported by current input driver
@@ -160,6 +162,7 @@ typedef struct rxRuntimeConfig_s {
     rcReadRawDataFnPtr rcReadRawFn;
     rcFrameStatusFnPtr rcFrameStatusFn;
     rcProcessFrameFnPtr rcProcessFrameFn;
+    rcFrameTimeUsFnPtr rcFrameTimeUsFn;     // Optional, time at which the last complete frame arrived
     rxLinkQualityTracker_e * lqTracker;     // Pointer to a
     uint16_t *channelData;
     void *frameData;
@@ -193,6 +196,13 @@ typedef struct rxLinkStatistics_s {
     char        mode[6];
 } rxLinkStatistics_t;
 
+typedef struct rxFrameTiming_s {
+    timeUs_t    lastFrameTimeUs;    // Arrival time of the last complete frame
+    timeDelta_t intervalUs;         // Time between the arrival of the last two frames
+    timeDelta_t latencyUs;          // Time between the arrival of the last frame and its processing
+    uint16_t    jitterUs;           // Filtered deviation of intervalUs from its average
+} rxFrameTiming_t;
+
 typedef uint16_t (*rcReadRawDataFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan); // used by receiver driver to return channel data
 typedef uint8_t (*rcFrameStatusFnPtr)(rxRuntimeConfig_t *rxRuntimeConfig);
 typedef bool (*rcProcessFrameFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
@@ -211,6 +221,7 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime);
 bool rxIsReceivingSignal(void);
 bool rxAreFlightChannelsValid(void);
 bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs);
+const rxFrameTiming_t *rxGetFrameTiming(void);
 bool isRxPulseValid(uint16_t pulseDuration);
 
 uint8_t calculateChannelRemapping(const uint8_t *channelMap, uint8_t channelMapEntryCount, uint8_t channelToRemap);
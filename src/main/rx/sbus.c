@@ -73,6 +73,7 @@ static uint8_t sbus2ActiveTelemetryPage = 0;
 static uint8_t sbus2ActiveTelemetrySlot = 0;
 static uint8_t sbus2ShortFrameInterval = 0;
 timeUs_t frameTime = 0;
+static volatile timeUs_t sbusFrameTimeUs = 0;
 
 // Receive ISR callback
 static void sbusDataReceive(uint16_t c, void *data)
@@ -149,6 +150,7 @@ static void sbusDataReceive(uint16_t c, void *data)
 
                     memcpy((void *)&sbusFrameData->frame, (void *)&sbusFrameData->buffer[0], SBUS_FRAME_SIZE);
                     sbusFrameData->frameDone = true;
+                    sbusFrameTimeUs = currentTimeUs;
                 }
             }
             break;
@@ -182,6 +184,7 @@ static void sbusDataReceive(uint16_t c, void *data)
                 if (!sbusFrameData->frameDone && frameValid) {
                     memcpy((void *)&sbusFrameData->frameHigh, (void *)&sbusFrameData->buffer[0], SBUS_FRAME_SIZE);
                     sbusFrameData->frameDone = true;
+                    sbusFrameTimeUs = currentTimeUs;
                     sbusFrameData->is26channels = true;
                 }
             }
@@ -194,6 +197,11 @@ static void sbusDataReceive(uint16_t c, void *data)
     }
 }
 
+static timeUs_t sbusGetFrameTimeUs(void)
+{
+    return sbusFrameTimeUs;
+}
+
 static uint8_t sbusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 {
     sbusFrameData_t *sbusFrameData = rxRuntimeConfig->frameData;
@@ -237,6 +245,7 @@ static bool sbusInitEx(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeC
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
 
     rxRuntimeConfig->rcFrameStatusFn = sbusFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = sbusGetFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
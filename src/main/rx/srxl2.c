@@ -95,6 +95,7 @@ static uint32_t fullTimeoutTimestamp = 0;
 static uint32_t lastValidPacketTimestamp = 0;
 static volatile uint32_t lastReceiveTimestamp = 0;
 static volatile uint32_t lastIdleTimestamp = 0;
+static volatile uint32_t lastPacketEndTimestamp = 0;
 
 struct rxBuf readBuffer[2];
 struct rxBuf* readBufferPtr = &readBuffer[0];
@@ -312,6 +313,7 @@ static void srxl2Idle(void)
     }
     else {
         lastIdleTimestamp = microsISR();
+        lastPacketEndTimestamp = lastReceiveTimestamp;
         //Swap read and process buffer pointers
         if(processBufferPtr == &readBuffer[0]) {
             processBufferPtr = &readBuffer[1];
@@ -326,6 +328,11 @@ static void srxl2Idle(void)
     readBufferIdx = 0;
 }
 
+static timeUs_t srxl2FrameTimeUs(void)
+{
+    return lastPacketEndTimestamp;
+}
+
 static uint8_t srxl2FrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
 {
     UNUSED(rxRuntimeConfig);
@@ -492,6 +499,7 @@ bool srxl2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->channelCount = SRXL2_MAX_CHANNELS;
     rxRuntimeConfig->rcReadRawFn = srxl2ReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = srxl2FrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = srxl2FrameTimeUs;
     rxRuntimeConfig->rcProcessFrameFn = srxl2ProcessFrame;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
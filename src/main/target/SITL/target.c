@@ -199,6 +199,7 @@ void printCmdLineOptions(void)
     printVersion();
     fprintf(stderr, "Avaiable options:\n");
     fprintf(stderr, "--path=[path]                  Path and filename of eeprom.bin. If not specified 'eeprom.bin' in program directory is used.\n");
+    fprintf(stderr, "--sharedeeprom                 Map eeprom.bin copy-on-write, so many instances can share it. Saved settings are kept in memory only.\n");
     fprintf(stderr, "--sim=[rf|xp]                  Simulator interface: rf = RealFligt, xp = XPlane. Example: --sim=rf\n");
     fprintf(stderr, "--simip=[ip]                   IP-Address oft the simulator host. If not specified localhost (127.0.0.1) is used.\n");
     fprintf(stderr, "--simport=[port]               Port oft the simulator host.\n");
@@ -232,6 +233,7 @@ void parseArguments(int argc, char *argv[])
             {"simport", required_argument, 0, 'p'},
             {"help", no_argument, 0, 'h'},
             {"path", required_argument, 0, 'e'},
+            {"sharedeeprom", no_argument, 0, 'E'},
             {"version", no_argument, 0, 'v'},
             {"serialuart", required_argument, 0, '0'},
             {"serialport", required_argument, 0, '1'},
@@ -278,6 +280,9 @@ void parseArguments(int argc, char *argv[])
                     fprintf(stderr, "[EEPROM] Invalid path, using eeprom file in program directory\n.");
                 }
                 break;
+            case 'E':
+                configFileSetShared(true);
+                break;
             case 'v':
                 printVersion();
                 exit(0);
@@ -186,7 +186,11 @@
 //ADSB RECEIVER
 #ifdef USE_GPS
 #define USE_ADSB
-#define MAX_ADSB_VEHICLES               5
+#if defined(STM32F7) || defined(STM32H7) || defined(SITL_BUILD)
+#define MAX_ADSB_VEHICLES               64
+#else
+#define MAX_ADSB_VEHICLES               16
+#endif
 #define ADSB_LIMIT_CM                   6400000
 #endif
 
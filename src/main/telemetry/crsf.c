@@ -105,27 +105,38 @@ bool bufferCrsfMspFrame(uint8_t *frameStart, int frameLength)
     }
 }
 
+// Sends at most one reply frame per call, as the RX only holds a single
+// telemetry frame. Returns true while there is more to send.
 bool handleCrsfMspFrameBuffer(uint8_t payloadSize, mspResponseFnPtr responseFn)
 {
-    bool requestHandled = false;
-    if (!mspRxBuffer.len) {
-        return false;
+    static bool replyPending = false;
+    static int pos = 0;
+
+    if (replyPending) {
+        // Finish the current reply before handling the next request,
+        // they share the response buffer
+        replyPending = sendMspReply(payloadSize, responseFn);
+        return true;
     }
-    int pos = 0;
-    while (true) {
+
+    bool sent = false;
+    while (!sent && pos < mspRxBuffer.len) {
         const int mspFrameLength = mspRxBuffer.bytes[pos];
         if (handleMspFrame(&mspRxBuffer.bytes[CRSF_MSP_LENGTH_OFFSET + pos], mspFrameLength)) {
-            requestHandled |= sendMspReply(payloadSize, responseFn);
+            replyPending = sendMspReply(payloadSize, responseFn);
+            sent = true;
         }
         pos += CRSF_MSP_LENGTH_OFFSET + mspFrameLength;
-        ATOMIC_BLOCK(NVIC_PRIO_SERIALUART) {
-            if (pos >= mspRxBuffer.len) {
-                mspRxBuffer.len = 0;
-                return requestHandled;
-            }
+    }
+
+    ATOMIC_BLOCK(NVIC_PRIO_SERIALUART) {
+        if (pos >= mspRxBuffer.len) {
+            mspRxBuffer.len = 0;
+            pos = 0;
         }
     }
-    return requestHandled;
+
+    return replyPending || mspRxBuffer.len > 0;
 }
 #endif
 
@@ -418,8 +429,17 @@ typedef enum {
     CRSF_SCHEDULE_COUNT_MAX
 } crsfFrameTypeIndex_e;
 
+// Frames are paced to spread CRSF_CYCLETIME_US over the enabled ones.
+// Each slot goes to the frame that has been due the longest, so slots
+// taken by MSP replies or missed while the RX was still busy delay all
+// frames evenly instead of always hitting the same one.
 static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+static uint8_t crsfScheduleEnabled;
+static timeUs_t crsfFrameDue[CRSF_SCHEDULE_COUNT_MAX];
+
+// While MSP replies are pending they get the free slots, but a due
+// telemetry frame goes out after at most this many of them
+#define CRSF_MSP_SLOTS_PER_TELEMETRY_FRAME  2
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -445,44 +465,51 @@ void crsfSendMspResponse(uint8_t *payload)
 }
 #endif
 
-static void processCrsf(void)
+static int crsfNextDueFrame(timeUs_t currentTimeUs)
 {
-    static uint8_t crsfScheduleIndex = 0;
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
+    int next = -1;
+    for (int ii = 0; ii < CRSF_SCHEDULE_COUNT_MAX; ii++) {
+        if (!(crsfScheduleEnabled & BV(ii)) || cmpTimeUs(currentTimeUs, crsfFrameDue[ii]) < 0) {
+            continue;
+        }
+        if (next < 0 || cmpTimeUs(crsfFrameDue[ii], crsfFrameDue[next]) < 0) {
+            next = ii;
+        }
+    }
+    return next;
+}
 
+static void processCrsf(crsfFrameTypeIndex_e frameIndex, timeUs_t currentTimeUs)
+{
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BV(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
+    crsfFrameDue[frameIndex] = currentTimeUs + CRSF_CYCLETIME_US;
+
+    crsfInitializeFrame(dst);
+    switch (frameIndex) {
+    default:
+    case CRSF_FRAME_ATTITUDE_INDEX:
         crsfFrameAttitude(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_BATTERY_SENSOR_INDEX:
         crsfFrameBatterySensor(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_FLIGHT_MODE_INDEX:
         crsfFrameFlightMode(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #ifdef USE_GPS
-    if (currentSchedule & BV(CRSF_FRAME_GPS_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_GPS_INDEX:
         crsfFrameGps(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
-    if (currentSchedule & BV(CRSF_FRAME_VARIO_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_VARIO_SENSOR_INDEX:
         crsfFrameVarioSensor(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
+    }
+    crsfFinalize(dst);
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -501,21 +528,22 @@ void initCrsfTelemetry(void)
     mspReplyPending = false;
 #endif
 
-    int index = 0;
-    crsfSchedule[index++] = BV(CRSF_FRAME_ATTITUDE_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_BATTERY_SENSOR_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_FLIGHT_MODE_INDEX);
+    crsfScheduleEnabled = BV(CRSF_FRAME_ATTITUDE_INDEX) | BV(CRSF_FRAME_BATTERY_SENSOR_INDEX) | BV(CRSF_FRAME_FLIGHT_MODE_INDEX);
 #ifdef USE_GPS
     if (feature(FEATURE_GPS)) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_GPS_INDEX);
+        crsfScheduleEnabled |= BV(CRSF_FRAME_GPS_INDEX);
     }
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
     if (sensors(SENSOR_BARO) || (STATE(FIXED_WING_LEGACY) && feature(FEATURE_GPS))) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_VARIO_SENSOR_INDEX);
+        crsfScheduleEnabled |= BV(CRSF_FRAME_VARIO_SENSOR_INDEX);
     }
 #endif
-    crsfScheduleCount = (uint8_t)index;
+    crsfScheduleCount = BITCOUNT(crsfScheduleEnabled);
+
+    for (int ii = 0; ii < CRSF_SCHEDULE_COUNT_MAX; ii++) {
+        crsfFrameDue[ii] = 0;
+    }
 }
 
 bool checkCrsfTelemetryState(void)
@@ -528,7 +556,10 @@ bool checkCrsfTelemetryState(void)
  */
 void handleCrsfTelemetry(timeUs_t currentTimeUs)
 {
-    static uint32_t crsfLastCycleTime;
+    static timeUs_t crsfLastCycleTime;
+#if defined(USE_MSP_OVER_TELEMETRY)
+    static uint8_t crsfMspSlotsInRow;
+#endif
 
     if (!crsfTelemetryEnabled) {
         return;
@@ -538,13 +569,24 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     // in between the RX frames.
     crsfRxSendTelemetryData();
 
+    // The RX holds a single frame, don't overwrite it before it went out
+    if (!crsfRxIsTelemetryBufEmpty()) {
+        return;
+    }
+
+    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
+    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
+    const bool telemetrySlot = cmpTimeUs(currentTimeUs, crsfLastCycleTime) >= (timeDelta_t)(CRSF_CYCLETIME_US / crsfScheduleCount);
+    const int frameIndex = telemetrySlot ? crsfNextDueFrame(currentTimeUs) : -1;
+
     // Send ad-hoc response frames as soon as possible
 #if defined(USE_MSP_OVER_TELEMETRY)
-    if (mspReplyPending) {
+    if (mspReplyPending && (frameIndex < 0 || crsfMspSlotsInRow < CRSF_MSP_SLOTS_PER_TELEMETRY_FRAME)) {
         mspReplyPending = handleCrsfMspFrameBuffer(CRSF_FRAME_TX_MSP_FRAME_SIZE, &crsfSendMspResponse);
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
+        crsfMspSlotsInRow++;
         return;
     }
+    crsfMspSlotsInRow = 0;
 #endif
 
     if (deviceInfoReplyPending) {
@@ -554,15 +596,12 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
         crsfFrameDeviceInfo(dst);
         crsfFinalize(dst);
         deviceInfoReplyPending = false;
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
+    if (frameIndex >= 0) {
         crsfLastCycleTime = currentTimeUs;
-        processCrsf();
+        processCrsf(frameIndex, currentTimeUs);
     }
 }
 
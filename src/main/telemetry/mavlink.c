@@ -35,8 +35,10 @@
 #include "common/axis.h"
 #include "common/color.h"
 #include "common/maths.h"
+#include "common/printf.h"
 #include "common/utils.h"
 #include "common/string_light.h"
+#include "common/typeconversion.h"
 
 #include "config/feature.h"
 
@@ -97,6 +99,9 @@
 #define TELEMETRY_MAVLINK_PORT_MODE     MODE_RXTX
 #define TELEMETRY_MAVLINK_MAXRATE       50
 #define TELEMETRY_MAVLINK_DELAY         ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
+// Bytes the link may take in one go after being idle. HEARTBEATs may
+// also run the budget this far into debt when the link is saturated.
+#define TELEMETRY_MAVLINK_BURST_BYTES   (2 * MAVLINK_MAX_PACKET_LEN)
 
 /**
  * MAVLink requires angles to be in the range -Pi..Pi.
@@ -165,6 +170,13 @@ static portSharing_e mavlinkPortSharing;
 static uint8_t txbuff_free = 100;
 static bool txbuff_valid = false;
 
+// Token bucket for the TX side of the link. Refilled from the port baud
+// rate, scaled down by the radio buffer fill when RADIO_STATUS is seen,
+// and drained by every message sent.
+static uint32_t mavLinkBytesPerSec;
+static int32_t mavTxBudget;
+static timeUs_t mavTxBudgetUpdated;
+
 /* MAVLink datastream rates in Hz */
 static uint8_t mavRates[] = {
     [MAV_DATA_STREAM_EXTENDED_STATUS] = 2,      // 2Hz
@@ -248,6 +260,29 @@ static APM_PLANE_MODE inavToArduPlaneMap(flightModeForTelemetry_e flightMode)
     }
 }
 
+static bool mavlinkTxPortHasRoom(void)
+{
+    return serialTxBytesFree(mavlinkPort) >= MAVLINK_MAX_PACKET_LEN;
+}
+
+static bool mavlinkStreamCanSend(enum MAV_DATA_STREAM streamNum)
+{
+    if (!mavlinkTxPortHasRoom()) {
+        return false;
+    }
+
+    // EXTRA2 carries the HEARTBEAT, which keeps the GCS connection
+    // alive, so it may borrow from the budget. VFR_HUD in the same
+    // stream is skipped when it would have to borrow, see
+    // mavlinkSendHUDAndHeartbeat(). Everything else waits for the link
+    // to drain.
+    if (streamNum == MAV_DATA_STREAM_EXTRA2) {
+        return mavTxBudget > -TELEMETRY_MAVLINK_BURST_BYTES;
+    }
+
+    return mavTxBudget > 0;
+}
+
 static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
 {
     uint8_t rate = (uint8_t) mavRates[streamNum];
@@ -256,6 +291,12 @@ static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
     }
 
     if (mavTicks[streamNum] == 0) {
+        // Keep the stream due until there is room for it, so its
+        // effective rate drops to what the link can carry
+        if (!mavlinkStreamCanSend(streamNum)) {
+            return 0;
+        }
+
         // we're triggering now, setup the next trigger point
         if (rate > TELEMETRY_MAVLINK_MAXRATE) {
             rate = TELEMETRY_MAVLINK_MAXRATE;
@@ -301,6 +342,10 @@ void configureMAVLinkTelemetryPort(void)
         return;
     }
 
+    // 8N1, 10 bits per byte
+    mavLinkBytesPerSec = baudRates[baudRateIndex] / 10;
+    mavTxBudget = TELEMETRY_MAVLINK_BURST_BYTES;
+
     mavlinkTelemetryEnabled = true;
 }
 
@@ -342,9 +387,30 @@ static void mavlinkSendMessage(void)
 
     int msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavSendMsg);
 
-    for (int i = 0; i < msgLength; i++) {
-        serialWrite(mavlinkPort, mavBuffer[i]);
+    serialWriteBuf(mavlinkPort, mavBuffer, msgLength);
+    mavTxBudget = MAX(mavTxBudget - msgLength, -TELEMETRY_MAVLINK_BURST_BYTES);
+}
+
+static void mavlinkUpdateTxBudget(timeUs_t currentTimeUs)
+{
+    const timeDelta_t dt = MIN(cmpTimeUs(currentTimeUs, mavTxBudgetUpdated), 1000000);
+    mavTxBudgetUpdated = currentTimeUs;
+
+    uint32_t bytesPerSec = mavLinkBytesPerSec;
+    if (txbuff_valid) {
+        // The radio air rate is usually below the serial rate. Follow
+        // its buffer: full speed when empty, nothing below min_txbuff.
+        if (txbuff_free >= telemetryConfig()->mavlink.min_txbuff) {
+            bytesPerSec = bytesPerSec * txbuff_free / 100;
+        } else {
+            // Drop any saved up burst as well, so only HEARTBEATs go out
+            bytesPerSec = 0;
+            mavTxBudget = MIN(mavTxBudget, 0);
+        }
     }
+
+    const int32_t refill = ((uint64_t)bytesPerSec * dt) / 1000000;
+    mavTxBudget = MIN(mavTxBudget + refill, TELEMETRY_MAVLINK_BURST_BYTES);
 }
 
 void mavlinkSendSystemStatus(void)
@@ -714,22 +780,25 @@ void mavlinkSendHUDAndHeartbeat(void)
     mavAltitude = getEstimatedActualPosition(Z) / 100.0f;
     mavClimbRate = getEstimatedActualVelocity(Z) / 100.0f;
 
-    int16_t thr = getThrottlePercent(osdUsingScaledThrottle());
-    mavlink_msg_vfr_hud_pack(mavSystemId, mavComponentId, &mavSendMsg,
-        // airspeed Current airspeed in m/s
-        mavAirSpeed,
-        // groundspeed Current ground speed in m/s
-        mavGroundSpeed,
-        // heading Current heading in degrees, in compass units (0..360, 0=north)
-        DECIDEGREES_TO_DEGREES(attitude.values.yaw),
-        // throttle Current throttle setting in integer percent, 0 to 100
-        thr,
-        // alt Current altitude (MSL), in meters, if we have surface or baro use them, otherwise use GPS (less accurate)
-        mavAltitude,
-        // climb Current climb rate in meters/second
-        mavClimbRate);
+    // Only the HEARTBEAT may borrow from the budget
+    if (mavTxBudget > 0) {
+        int16_t thr = getThrottlePercent(osdUsingScaledThrottle());
+        mavlink_msg_vfr_hud_pack(mavSystemId, mavComponentId, &mavSendMsg,
+            // airspeed Current airspeed in m/s
+            mavAirSpeed,
+            // groundspeed Current ground speed in m/s
+            mavGroundSpeed,
+            // heading Current heading in degrees, in compass units (0..360, 0=north)
+            DECIDEGREES_TO_DEGREES(attitude.values.yaw),
+            // throttle Current throttle setting in integer percent, 0 to 100
+            thr,
+            // alt Current altitude (MSL), in meters, if we have surface or baro use them, otherwise use GPS (less accurate)
+            mavAltitude,
+            // climb Current climb rate in meters/second
+            mavClimbRate);
 
-    mavlinkSendMessage();
+        mavlinkSendMessage();
+    }
 
 
     uint8_t mavModes = MAV_MODE_FLAG_MANUAL_INPUT_ENABLED | MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
@@ -905,15 +974,199 @@ void mavlinkSendBatteryTemperatureStatusText(void)
 
 }
 
+/*
+ * Settings are exposed as MAVLink parameters, except strings which have
+ * no PARAM_VALUE representation. Parameter ids are limited to 16 chars,
+ * so longer setting names are sent as their first 11 chars followed by
+ * "_" and the 4 digit setting index, which mavlinkFindParam() maps back.
+ */
+#define MAVLINK_PARAM_ID_LEN        16
+#define MAVLINK_PARAM_PREFIX_LEN    11
+
+static uint16_t mavParamCount;
+// Position of an in progress PARAM_REQUEST_LIST transfer
+static uint16_t mavParamStreamSetting = SETTINGS_TABLE_COUNT;
+static uint16_t mavParamStreamIndex;
+
+static bool mavlinkIsParam(const setting_t *setting)
+{
+    return SETTING_TYPE(setting) != VAR_STRING;
+}
+
+static uint16_t mavlinkGetParamCount(void)
+{
+    if (mavParamCount == 0) {
+        for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+            if (mavlinkIsParam(settingGet(ii))) {
+                mavParamCount++;
+            }
+        }
+    }
+    return mavParamCount;
+}
+
+static const setting_t *mavlinkGetParamByIndex(int paramIndex)
+{
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+        const setting_t *setting = settingGet(ii);
+        if (mavlinkIsParam(setting) && paramIndex-- == 0) {
+            return setting;
+        }
+    }
+    return NULL;
+}
+
+static uint16_t mavlinkGetParamIndex(const setting_t *setting)
+{
+    uint16_t paramIndex = 0;
+    for (unsigned ii = 0; ii < settingGetIndex(setting); ii++) {
+        if (mavlinkIsParam(settingGet(ii))) {
+            paramIndex++;
+        }
+    }
+    return paramIndex;
+}
+
+static void mavlinkGetParamId(const setting_t *setting, char *paramId)
+{
+    char name[SETTING_MAX_NAME_LENGTH];
+    settingGetName(setting, name);
+
+    if (strlen(name) <= MAVLINK_PARAM_ID_LEN) {
+        strcpy(paramId, name);
+    } else {
+        memcpy(paramId, name, MAVLINK_PARAM_PREFIX_LEN);
+        tfp_sprintf(paramId + MAVLINK_PARAM_PREFIX_LEN, "_%04u", settingGetIndex(setting));
+    }
+}
+
+static const setting_t *mavlinkFindParam(const char *paramId)
+{
+    const setting_t *setting = settingFind(paramId);
+
+    if (!setting && strlen(paramId) == MAVLINK_PARAM_ID_LEN && paramId[MAVLINK_PARAM_PREFIX_LEN] == '_') {
+        // Shortened name, check the prefix matches the setting it points to
+        char id[MAVLINK_PARAM_ID_LEN + 1];
+        setting = settingGet(fastA2I(paramId + MAVLINK_PARAM_PREFIX_LEN + 1));
+        if (setting) {
+            mavlinkGetParamId(setting, id);
+            if (strcmp(id, paramId) != 0) {
+                setting = NULL;
+            }
+        }
+    }
+
+    return setting && mavlinkIsParam(setting) ? setting : NULL;
+}
+
+static void mavlinkSendParam(const setting_t *setting, uint16_t paramIndex)
+{
+    // PARAM_VALUE always carries all 16 bytes
+    char paramId[MAVLINK_PARAM_ID_LEN + 1] = { 0 };
+    mavlinkGetParamId(setting, paramId);
+
+    // Values are sent as float, like ArduPilot does
+    const void *ptr = settingGetValuePointer(setting);
+    float value = 0;
+    uint8_t type = MAV_PARAM_TYPE_REAL32;
+    switch (SETTING_TYPE(setting)) {
+        case VAR_UINT8:
+            value = *(const uint8_t *)ptr;
+            type = MAV_PARAM_TYPE_UINT8;
+            break;
+        case VAR_INT8:
+            value = *(const int8_t *)ptr;
+            type = MAV_PARAM_TYPE_INT8;
+            break;
+        case VAR_UINT16:
+            value = *(const uint16_t *)ptr;
+            type = MAV_PARAM_TYPE_UINT16;
+            break;
+        case VAR_INT16:
+            value = *(const int16_t *)ptr;
+            type = MAV_PARAM_TYPE_INT16;
+            break;
+        case VAR_UINT32:
+            // Exact up to 2^24 only, larger values lose their low bits
+            value = *(const uint32_t *)ptr;
+            type = MAV_PARAM_TYPE_UINT32;
+            break;
+        case VAR_FLOAT:
+            value = *(const float *)ptr;
+            break;
+        case VAR_STRING:
+            return;
+    }
+
+    mavlink_msg_param_value_pack(mavSystemId, mavComponentId, &mavSendMsg, paramId, value, type, mavlinkGetParamCount(), paramIndex);
+    mavlinkSendMessage();
+}
+
+static bool mavlinkSetParam(const setting_t *setting, float value)
+{
+    // NaN fails every comparison and would pass the range check below
+    if (!isfinite(value)) {
+        return false;
+    }
+
+    if (value < (float)settingGetMin(setting) || value > (float)settingGetMax(setting)) {
+        return false;
+    }
+
+    void *ptr = settingGetValuePointer(setting);
+    switch (SETTING_TYPE(setting)) {
+        case VAR_UINT8:
+            *(uint8_t *)ptr = lrintf(value);
+            break;
+        case VAR_INT8:
+            *(int8_t *)ptr = lrintf(value);
+            break;
+        case VAR_UINT16:
+            *(uint16_t *)ptr = lrintf(value);
+            break;
+        case VAR_INT16:
+            *(int16_t *)ptr = lrintf(value);
+            break;
+        case VAR_UINT32:
+            // A float holds integers exactly only up to 2^24. Above that
+            // the GCS can't send the value it means, so refuse it rather
+            // than store something close to it.
+            if (value > (float)(1 << 24)) {
+                return false;
+            }
+            *(uint32_t *)ptr = llrintf(value);
+            break;
+        case VAR_FLOAT:
+            *(float *)ptr = value;
+            break;
+        case VAR_STRING:
+            return false;
+    }
+    return true;
+}
+
+static void mavlinkSendParamList(void)
+{
+    // Parameters only get the bandwidth left over by the streams
+    while (mavParamStreamSetting < SETTINGS_TABLE_COUNT && mavTxBudget > 0 && mavlinkTxPortHasRoom()) {
+        const setting_t *setting = settingGet(mavParamStreamSetting++);
+        if (mavlinkIsParam(setting)) {
+            mavlinkSendParam(setting, mavParamStreamIndex++);
+        }
+    }
+}
+
 void processMAVLinkTelemetry(timeUs_t currentTimeUs)
 {
-    // is executed @ TELEMETRY_MAVLINK_MAXRATE rate
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTENDED_STATUS)) {
-        mavlinkSendSystemStatus();
+    // is executed @ TELEMETRY_MAVLINK_MAXRATE rate. Streams are
+    // checked in priority order, so when the link budget runs out
+    // the less important ones are the ones delayed.
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
+        mavlinkSendHUDAndHeartbeat();
     }
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_RC_CHANNELS)) {
-        mavlinkSendRCChannelsAndRSSI();
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
+        mavlinkSendAttitude();
     }
 
 #ifdef USE_GPS
@@ -922,18 +1175,20 @@ void processMAVLinkTelemetry(timeUs_t currentTimeUs)
     }
 #endif
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
-        mavlinkSendAttitude();
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTENDED_STATUS)) {
+        mavlinkSendSystemStatus();
     }
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
-        mavlinkSendHUDAndHeartbeat();
+    if (mavlinkStreamTrigger(MAV_DATA_STREAM_RC_CHANNELS)) {
+        mavlinkSendRCChannelsAndRSSI();
     }
 
     if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA3)) {
         mavlinkSendBatteryTemperatureStatusText();
     }
 
+    mavlinkSendParamList();
+
 }
 
 static bool handleIncoming_MISSION_CLEAR_ALL(void)
@@ -955,6 +1210,17 @@ static bool handleIncoming_MISSION_CLEAR_ALL(void)
 // Static state for MISSION UPLOAD transaction (starting with MISSION_COUNT)
 static int incomingMissionWpCount = 0;
 static int incomingMissionWpSequence = 0;
+static bool incomingMissionUseInt = false;
+
+static void mavlinkSendMissionRequest(uint16_t seq)
+{
+    if (incomingMissionUseInt) {
+        mavlink_msg_mission_request_int_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, seq, MAV_MISSION_TYPE_MISSION);
+    } else {
+        mavlink_msg_mission_request_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, seq, MAV_MISSION_TYPE_MISSION);
+    }
+    mavlinkSendMessage();
+}
 
 static bool handleIncoming_MISSION_COUNT(void)
 {
@@ -966,8 +1232,10 @@ static bool handleIncoming_MISSION_COUNT(void)
         if (msg.count <= NAV_MAX_WAYPOINTS) {
             incomingMissionWpCount = msg.count; // We need to know how many items to request
             incomingMissionWpSequence = 0;
-            mavlink_msg_mission_request_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, incomingMissionWpSequence, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
+            // MISSION_ITEM_INT needs MAVLink 2, fall back to MISSION_ITEM
+            // if the GCS answers with that instead
+            incomingMissionUseInt = telemetryConfig()->mavlink.version != 1;
+            mavlinkSendMissionRequest(incomingMissionWpSequence);
             return true;
         }
         else if (ARMING_FLAG(ARMED)) {
@@ -985,6 +1253,79 @@ static bool handleIncoming_MISSION_COUNT(void)
     return false;
 }
 
+static void mavlinkSendMissionUploadResult(void)
+{
+    if (isWaypointListValid()) {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+    }
+    else {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+    }
+}
+
+// Shared by MISSION_ITEM and MISSION_ITEM_INT, coordinates in deg * 1e7
+static void mavlinkHandleMissionItem(uint16_t seq, uint8_t frame, uint16_t command, uint8_t autocontinue, int32_t lat, int32_t lon, float alt)
+{
+    // Check supported values first
+    if (ARMING_FLAG(ARMED)) {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+        return;
+    }
+
+    if ((autocontinue == 0) || (command != MAV_CMD_NAV_WAYPOINT && command != MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+        return;
+    }
+
+    if ((frame != MAV_FRAME_GLOBAL_RELATIVE_ALT) && (frame != MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) && !(frame == MAV_FRAME_MISSION && command == MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED_FRAME, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+        return;
+    }
+
+    if (seq == incomingMissionWpSequence) {
+        incomingMissionWpSequence++;
+
+        navWaypoint_t wp;
+        wp.action = (command == MAV_CMD_NAV_RETURN_TO_LAUNCH) ? NAV_WP_ACTION_RTH : NAV_WP_ACTION_WAYPOINT;
+        wp.lat = lat;
+        wp.lon = lon;
+        wp.alt = alt * 100.0f;
+        wp.p1 = 0;
+        wp.p2 = 0;
+        wp.p3 = 0;
+        wp.flag = (incomingMissionWpSequence >= incomingMissionWpCount) ? NAV_WP_FLAG_LAST : 0;
+
+        setWaypoint(incomingMissionWpSequence, &wp);
+
+        if (incomingMissionWpSequence >= incomingMissionWpCount) {
+            mavlinkSendMissionUploadResult();
+        }
+        else {
+            mavlinkSendMissionRequest(incomingMissionWpSequence);
+        }
+    }
+    else if (seq + 1 == incomingMissionWpSequence) {
+        // Our request or ack got lost and the GCS resent the previous
+        // item. Answer again instead of aborting the whole upload.
+        if (incomingMissionWpSequence >= incomingMissionWpCount) {
+            mavlinkSendMissionUploadResult();
+        }
+        else {
+            mavlinkSendMissionRequest(incomingMissionWpSequence);
+        }
+    }
+    else {
+        // Wrong sequence number received
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+    }
+}
+
 static bool handleIncoming_MISSION_ITEM(void)
 {
     mavlink_mission_item_t msg;
@@ -992,61 +1333,23 @@ static bool handleIncoming_MISSION_ITEM(void)
 
     // Check if this message is for us
     if (msg.target_system == mavSystemId) {
-        // Check supported values first
-        if (ARMING_FLAG(ARMED)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
-
-        if ((msg.autocontinue == 0) || (msg.command != MAV_CMD_NAV_WAYPOINT && msg.command != MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
+        incomingMissionUseInt = false;
+        mavlinkHandleMissionItem(msg.seq, msg.frame, msg.command, msg.autocontinue, (int32_t)(msg.x * 1e7f), (int32_t)(msg.y * 1e7f), msg.z);
+        return true;
+    }
 
-        if ((msg.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT) && !(msg.frame == MAV_FRAME_MISSION && msg.command == MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED_FRAME, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
+    return false;
+}
 
-        if (msg.seq == incomingMissionWpSequence) {
-            incomingMissionWpSequence++;
-
-            navWaypoint_t wp;
-            wp.action = (msg.command == MAV_CMD_NAV_RETURN_TO_LAUNCH) ? NAV_WP_ACTION_RTH : NAV_WP_ACTION_WAYPOINT;
-            wp.lat = (int32_t)(msg.x * 1e7f);
-            wp.lon = (int32_t)(msg.y * 1e7f);
-            wp.alt = msg.z * 100.0f;
-            wp.p1 = 0;
-            wp.p2 = 0;
-            wp.p3 = 0;
-            wp.flag = (incomingMissionWpSequence >= incomingMissionWpCount) ? NAV_WP_FLAG_LAST : 0;
-
-            setWaypoint(incomingMissionWpSequence, &wp);
-
-            if (incomingMissionWpSequence >= incomingMissionWpCount) {
-                if (isWaypointListValid()) {
-                    mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED, MAV_MISSION_TYPE_MISSION);
-                    mavlinkSendMessage();
-                }
-                else {
-                    mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID, MAV_MISSION_TYPE_MISSION);
-                    mavlinkSendMessage();
-                }
-            }
-            else {
-                mavlink_msg_mission_request_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, incomingMissionWpSequence, MAV_MISSION_TYPE_MISSION);
-                mavlinkSendMessage();
-            }
-        }
-        else {
-            // Wrong sequence number received
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
+static bool handleIncoming_MISSION_ITEM_INT(void)
+{
+    mavlink_mission_item_int_t msg;
+    mavlink_msg_mission_item_int_decode(&mavRecvMsg, &msg);
 
+    // Check if this message is for us
+    if (msg.target_system == mavSystemId) {
+        incomingMissionUseInt = true;
+        mavlinkHandleMissionItem(msg.seq, msg.frame, msg.command, msg.autocontinue, msg.x, msg.y, msg.z);
         return true;
     }
 
@@ -1068,6 +1371,46 @@ static bool handleIncoming_MISSION_REQUEST_LIST(void)
     return false;
 }
 
+static void mavlinkSendMissionItem(uint16_t seq, bool useInt)
+{
+    if (seq >= getWaypointCount()) {
+        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
+        mavlinkSendMessage();
+        return;
+    }
+
+    navWaypoint_t wp;
+    getWaypoint(seq + 1, &wp);
+
+    const bool isRTH = wp.action == NAV_WP_ACTION_RTH;
+    if (useInt) {
+        mavlink_msg_mission_item_int_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid,
+                    seq,
+                    isRTH ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT_INT,
+                    isRTH ? MAV_CMD_NAV_RETURN_TO_LAUNCH : MAV_CMD_NAV_WAYPOINT,
+                    0,
+                    1,
+                    0, 0, 0, 0,
+                    wp.lat,
+                    wp.lon,
+                    wp.alt / 100.0f,
+                    MAV_MISSION_TYPE_MISSION);
+    } else {
+        mavlink_msg_mission_item_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid,
+                    seq,
+                    isRTH ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT,
+                    isRTH ? MAV_CMD_NAV_RETURN_TO_LAUNCH : MAV_CMD_NAV_WAYPOINT,
+                    0,
+                    1,
+                    0, 0, 0, 0,
+                    wp.lat / 1e7f,
+                    wp.lon / 1e7f,
+                    wp.alt / 100.0f,
+                    MAV_MISSION_TYPE_MISSION);
+    }
+    mavlinkSendMessage();
+}
+
 static bool handleIncoming_MISSION_REQUEST(void)
 {
     mavlink_mission_request_t msg;
@@ -1075,30 +1418,21 @@ static bool handleIncoming_MISSION_REQUEST(void)
 
     // Check if this message is for us
     if (msg.target_system == mavSystemId) {
-        int wpCount = getWaypointCount();
-
-        if (msg.seq < wpCount) {
-            navWaypoint_t wp;
-            getWaypoint(msg.seq + 1, &wp);
-
-            mavlink_msg_mission_item_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid,
-                        msg.seq,
-                        wp.action == NAV_WP_ACTION_RTH ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT,
-                        wp.action == NAV_WP_ACTION_RTH ? MAV_CMD_NAV_RETURN_TO_LAUNCH : MAV_CMD_NAV_WAYPOINT,
-                        0,
-                        1,
-                        0, 0, 0, 0,
-                        wp.lat / 1e7f,
-                        wp.lon / 1e7f,
-                        wp.alt / 100.0f,
-                        MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
-        else {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
+        mavlinkSendMissionItem(msg.seq, false);
+        return true;
+    }
+
+    return false;
+}
+
+static bool handleIncoming_MISSION_REQUEST_INT(void)
+{
+    mavlink_mission_request_int_t msg;
+    mavlink_msg_mission_request_int_decode(&mavRecvMsg, &msg);
 
+    // Check if this message is for us
+    if (msg.target_system == mavSystemId) {
+        mavlinkSendMissionItem(msg.seq, true);
         return true;
     }
 
@@ -1117,12 +1451,90 @@ static bool handleIncoming_PARAM_REQUEST_LIST(void) {
     mavlink_param_request_list_t msg;
     mavlink_msg_param_request_list_decode(&mavRecvMsg, &msg);
 
-    // Respond that we don't have any parameters to force Mission Planner to give up quickly
     if (msg.target_system == mavSystemId) {
-        // mavlink_msg_param_value_pack(system_id, component_id, msg, param_value->param_id, param_value->param_value, param_value->param_type, param_value->param_count, param_value->param_index);
-        mavlink_msg_param_value_pack(mavSystemId, mavComponentId, &mavSendMsg, 0, 0, 0, 0, 0);
-        mavlinkSendMessage();
+        // Sent from processMAVLinkTelemetry(), paced to the link
+        mavParamStreamSetting = 0;
+        mavParamStreamIndex = 0;
+    }
+    return true;
+}
+
+static bool handleIncoming_PARAM_REQUEST_READ(void) {
+    mavlink_param_request_read_t msg;
+    mavlink_msg_param_request_read_decode(&mavRecvMsg, &msg);
+
+    if (msg.target_system == mavSystemId) {
+        const setting_t *setting;
+        if (msg.param_index >= 0) {
+            setting = mavlinkGetParamByIndex(msg.param_index);
+        } else {
+            char paramId[MAVLINK_PARAM_ID_LEN + 1];
+            strncpy(paramId, msg.param_id, MAVLINK_PARAM_ID_LEN);
+            paramId[MAVLINK_PARAM_ID_LEN] = '\0';
+            setting = mavlinkFindParam(paramId);
+        }
+
+        if (setting) {
+            mavlinkSendParam(setting, mavlinkGetParamIndex(setting));
+        }
+    }
+    return true;
+}
+
+static bool handleIncoming_PARAM_SET(void) {
+    mavlink_param_set_t msg;
+    mavlink_msg_param_set_decode(&mavRecvMsg, &msg);
+
+    if (msg.target_system == mavSystemId) {
+        char paramId[MAVLINK_PARAM_ID_LEN + 1];
+        strncpy(paramId, msg.param_id, MAVLINK_PARAM_ID_LEN);
+        paramId[MAVLINK_PARAM_ID_LEN] = '\0';
+
+        const setting_t *setting = mavlinkFindParam(paramId);
+        if (setting) {
+            // Always answer with the current value, the GCS uses it to
+            // tell whether the change was accepted. Like mission uploads,
+            // changes are refused while armed.
+            if (!ARMING_FLAG(ARMED)) {
+                mavlinkSetParam(setting, msg.param_value);
+            }
+            mavlinkSendParam(setting, mavlinkGetParamIndex(setting));
+        }
+    }
+    return true;
+}
+
+static bool handleIncoming_COMMAND_LONG(void) {
+    mavlink_command_long_t msg;
+    mavlink_msg_command_long_decode(&mavRecvMsg, &msg);
+
+    if (msg.target_system != mavSystemId) {
+        return false;
     }
+
+    uint8_t result = MAV_RESULT_UNSUPPORTED;
+    switch (msg.command) {
+        case MAV_CMD_PREFLIGHT_STORAGE:
+            // Only writing the parameters is supported. Saving stalls the FC
+            // while the flash is written, so never while armed.
+            if (msg.param1 == 1.0f) {
+                if (ARMING_FLAG(ARMED)) {
+                    result = MAV_RESULT_TEMPORARILY_REJECTED;
+                } else {
+                    suspendRxSignal();
+                    writeEEPROM();
+                    readEEPROM();
+                    resumeRxSignal();
+                    result = MAV_RESULT_ACCEPTED;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+
+    mavlink_msg_command_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, msg.command, result, 0, 0, mavRecvMsg.sysid, mavRecvMsg.compid);
+    mavlinkSendMessage();
     return true;
 }
 
@@ -1235,16 +1647,26 @@ static bool processMAVLinkIncomingTelemetry(void)
                    return handleIncoming_HEARTBEAT();
                 case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
                     return handleIncoming_PARAM_REQUEST_LIST();
+                case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+                    return handleIncoming_PARAM_REQUEST_READ();
+                case MAVLINK_MSG_ID_PARAM_SET:
+                    return handleIncoming_PARAM_SET();
+                case MAVLINK_MSG_ID_COMMAND_LONG:
+                    return handleIncoming_COMMAND_LONG();
                 case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
                     return handleIncoming_MISSION_CLEAR_ALL();
                 case MAVLINK_MSG_ID_MISSION_COUNT:
                     return handleIncoming_MISSION_COUNT();
                 case MAVLINK_MSG_ID_MISSION_ITEM:
                     return handleIncoming_MISSION_ITEM();
+                case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+                    return handleIncoming_MISSION_ITEM_INT();
                 case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
                     return handleIncoming_MISSION_REQUEST_LIST();
                 case MAVLINK_MSG_ID_MISSION_REQUEST:
                     return handleIncoming_MISSION_REQUEST();
+                case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+                    return handleIncoming_MISSION_REQUEST_INT();
                 case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
                     handleIncoming_RC_CHANNELS_OVERRIDE();
                     // Don't set that we handled a message, otherwise RC channel packets will block telemetry messages
@@ -1281,21 +1703,16 @@ void handleMAVLinkTelemetry(timeUs_t currentTimeUs)
         return;
     }
 
-    // Process incoming MAVLink
+    // Process incoming MAVLink. Replies count against the TX budget
+    // too, so streams back off while e.g. a mission is being uploaded.
     bool receivedMessage = processMAVLinkIncomingTelemetry();
-    bool shouldSendTelemetry = false;
 
-    // Determine whether to send telemetry back based on flow control / pacing
-    if (txbuff_valid) {
-        // Use flow control if available
-        shouldSendTelemetry = txbuff_free >= telemetryConfig()->mavlink.min_txbuff;
-    } else {
-        // If not, use blind frame pacing - and back off for collision avoidance if half-duplex
-        bool halfDuplexBackoff = (isMAVLinkTelemetryHalfDuplex() && receivedMessage);
-        shouldSendTelemetry = ((currentTimeUs - lastMavlinkMessage) >= TELEMETRY_MAVLINK_DELAY) && !halfDuplexBackoff;
-    }
+    // Without flow control, back off for collision avoidance if half-duplex
+    bool halfDuplexBackoff = !txbuff_valid && isMAVLinkTelemetryHalfDuplex() && receivedMessage;
+    bool shouldSendTelemetry = ((currentTimeUs - lastMavlinkMessage) >= TELEMETRY_MAVLINK_DELAY) && !halfDuplexBackoff;
 
     if (shouldSendTelemetry) {
+        mavlinkUpdateTxBudget(currentTimeUs);
         processMAVLinkTelemetry(currentTimeUs);
         lastMavlinkMessage = currentTimeUs;
     }
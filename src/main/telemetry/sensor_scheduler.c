@@ -0,0 +1,87 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common/maths.h"
+
+#include "telemetry/sensor_scheduler.h"
+
+#define TELEMETRY_SENSOR_CHANGED_BOOST      4
+#define TELEMETRY_SENSOR_UNCHANGED_DAMPING  4
+
+void telemetrySensorsReset(telemetrySensor_t *sensors, unsigned count)
+{
+    for (unsigned ii = 0; ii < count; ii++) {
+        sensors[ii].lastValue = 0;
+        sensors[ii].lastSentMs = 0;
+        sensors[ii].sent = false;
+    }
+}
+
+static uint32_t telemetrySensorScore(const telemetrySensor_t *sensor, int32_t value, timeMs_t now)
+{
+    if (!sensor->sent) {
+        // Never sent, go ahead of everything else
+        return UINT32_MAX;
+    }
+
+    const uint32_t age = MIN(now - sensor->lastSentMs, (timeMs_t)TELEMETRY_SENSOR_MAX_AGE_MS);
+    uint32_t score = (age + 1) * sensor->priority;
+
+    const int64_t change = (int64_t)value - sensor->lastValue;
+    if (llabs(change) >= MAX(sensor->threshold, 1)) {
+        score *= TELEMETRY_SENSOR_CHANGED_BOOST;
+    } else {
+        score /= TELEMETRY_SENSOR_UNCHANGED_DAMPING;
+    }
+
+    return score;
+}
+
+// Returns the sensor to send next and its value, or NULL if none is available
+telemetrySensor_t *telemetrySensorNext(telemetrySensor_t *sensors, unsigned count, timeMs_t now, telemetrySensorReadFn *read, int32_t *value)
+{
+    telemetrySensor_t *best = NULL;
+    uint32_t bestScore = 0;
+
+    for (unsigned ii = 0; ii < count; ii++) {
+        telemetrySensor_t *sensor = &sensors[ii];
+        int32_t current;
+        if (sensor->priority == 0 || !read(sensor, &current)) {
+            continue;
+        }
+
+        const uint32_t score = telemetrySensorScore(sensor, current, now);
+        if (!best || score > bestScore) {
+            best = sensor;
+            bestScore = score;
+            *value = current;
+        }
+    }
+
+    return best;
+}
+
+void telemetrySensorMarkSent(telemetrySensor_t *sensor, int32_t value, timeMs_t now)
+{
+    sensor->lastValue = value;
+    sensor->lastSentMs = now;
+    sensor->sent = true;
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+/*
+ * Picks which telemetry value goes into the next free slot of a link.
+ * Each value scores (time since last sent) * priority, boosted when it
+ * moved by at least its threshold since it was last sent and damped when
+ * it didn't, so fast changing values are refreshed more often while
+ * unchanged ones still go out now and then.
+ */
+
+// Age beyond which a value isn't considered any more stale
+#define TELEMETRY_SENSOR_MAX_AGE_MS     10000
+
+typedef struct telemetrySensor_s {
+    uint16_t id;                // Backend specific
+    uint8_t priority;           // Relative weight, 0 disables the value
+    uint16_t threshold;         // Change that counts as a new value, in sent units
+
+    // State, zero initialised
+    int32_t lastValue;
+    timeMs_t lastSentMs;
+    bool sent;
+} telemetrySensor_t;
+
+// Returns false when the value can't be sent right now (e.g. no GPS fix)
+typedef bool telemetrySensorReadFn(const telemetrySensor_t *sensor, int32_t *value);
+
+void telemetrySensorsReset(telemetrySensor_t *sensors, unsigned count);
+telemetrySensor_t *telemetrySensorNext(telemetrySensor_t *sensors, unsigned count, timeMs_t now, telemetrySensorReadFn *read, int32_t *value);
+void telemetrySensorMarkSent(telemetrySensor_t *sensor, int32_t value, timeMs_t now);
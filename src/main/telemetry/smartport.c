@@ -59,6 +59,7 @@
 #include "telemetry/telemetry.h"
 #include "telemetry/smartport.h"
 #include "telemetry/msp_shared.h"
+#include "telemetry/sensor_scheduler.h"
 
 // these data identifiers are obtained from https://github.com/opentx/opentx/blob/2.3/radio/src/telemetry/frsky.h
 enum
@@ -95,37 +96,35 @@ enum
     FSSP_DATAID_GNSS            = 0x0480,
 };
 
-const uint16_t frSkyDataIdTable[] = {
-    FSSP_DATAID_SPEED,
-    FSSP_DATAID_VFAS,
-    FSSP_DATAID_CURRENT,
-    //FSSP_DATAID_RPM,
-    FSSP_DATAID_ALTITUDE,
-    FSSP_DATAID_FUEL,
-    //FSSP_DATAID_ADC1,
-    //FSSP_DATAID_ADC2,
-    FSSP_DATAID_LATLONG,
-    FSSP_DATAID_LATLONG, // twice
-    //FSSP_DATAID_CAP_USED,
-    FSSP_DATAID_VARIO,
-    //FSSP_DATAID_CELLS,
-    //FSSP_DATAID_CELLS_LAST,
-    FSSP_DATAID_HEADING,
-    FSSP_DATAID_FPV,
-    FSSP_DATAID_PITCH,
-    FSSP_DATAID_ROLL,
-    FSSP_DATAID_ACCX,
-    FSSP_DATAID_ACCY,
-    FSSP_DATAID_ACCZ,
-    FSSP_DATAID_MODES,
-    FSSP_DATAID_GNSS,
-    FSSP_DATAID_HOME_DIST,
-    FSSP_DATAID_GPS_ALT,
-    FSSP_DATAID_ASPD,
-    // FSSP_DATAID_A3,
-    FSSP_DATAID_A4,
-    FSSP_DATAID_AZIMUTH,
-    0
+// Longitude goes out as FSSP_DATAID_LATLONG too, this id is only used
+// to schedule it separately from latitude
+#define FSSP_DATAID_LONGITUDE   (FSSP_DATAID_LATLONG + 1)
+
+// Attitude, altitude and position change fast and are worth the most
+// slots, the rest mostly needs an occasional refresh.
+static telemetrySensor_t smartPortSensors[] = {
+    { .id = FSSP_DATAID_SPEED,      .priority = 2, .threshold = 500 },  // knots/1000
+    { .id = FSSP_DATAID_VFAS,       .priority = 2, .threshold = 5 },    // 0.01V
+    { .id = FSSP_DATAID_CURRENT,    .priority = 2, .threshold = 2 },    // 0.1A
+    { .id = FSSP_DATAID_ALTITUDE,   .priority = 4, .threshold = 20 },   // cm
+    { .id = FSSP_DATAID_FUEL,       .priority = 1, .threshold = 1 },
+    { .id = FSSP_DATAID_LATLONG,    .priority = 3, .threshold = 5 },
+    { .id = FSSP_DATAID_LONGITUDE,  .priority = 3, .threshold = 5 },
+    { .id = FSSP_DATAID_VARIO,      .priority = 4, .threshold = 10 },   // cm/s
+    { .id = FSSP_DATAID_HEADING,    .priority = 3, .threshold = 20 },   // 0.01deg
+    { .id = FSSP_DATAID_FPV,        .priority = 2, .threshold = 20 },   // 0.1deg
+    { .id = FSSP_DATAID_PITCH,      .priority = 4, .threshold = 10 },   // 0.1deg
+    { .id = FSSP_DATAID_ROLL,       .priority = 4, .threshold = 10 },   // 0.1deg
+    { .id = FSSP_DATAID_ACCX,       .priority = 2, .threshold = 5 },    // 0.01G
+    { .id = FSSP_DATAID_ACCY,       .priority = 2, .threshold = 5 },    // 0.01G
+    { .id = FSSP_DATAID_ACCZ,       .priority = 2, .threshold = 5 },    // 0.01G
+    { .id = FSSP_DATAID_MODES,      .priority = 2, .threshold = 1 },
+    { .id = FSSP_DATAID_GNSS,       .priority = 1, .threshold = 1 },
+    { .id = FSSP_DATAID_HOME_DIST,  .priority = 2, .threshold = 1 },    // m
+    { .id = FSSP_DATAID_GPS_ALT,    .priority = 2, .threshold = 50 },   // cm
+    { .id = FSSP_DATAID_ASPD,       .priority = 2, .threshold = 1 },    // knots
+    { .id = FSSP_DATAID_A4,         .priority = 1, .threshold = 5 },    // 0.01V
+    { .id = FSSP_DATAID_AZIMUTH,    .priority = 1, .threshold = 50 },   // 0.1deg
 };
 
 #define __USE_C99_MATH // for roundf()
@@ -146,7 +145,6 @@ enum
 };
 
 static uint8_t telemetryState = TELEMETRY_STATE_UNINITIALIZED;
-static uint8_t smartPortIdCnt = 0;
 
 typedef struct smartPortFrame_s {
     uint8_t  sensorId;
@@ -384,6 +382,7 @@ static void configureSmartPortTelemetryPort(void)
         portOptions_t portOptions = (telemetryConfig()->halfDuplex ? SERIAL_BIDIR : SERIAL_UNIDIR) | (telemetryConfig()->telemetry_inverted ? SERIAL_NOT_INVERTED : SERIAL_INVERTED);
 
         smartPortSerialPort = openSerialPort(portConfig->identifier, FUNCTION_TELEMETRY_SMARTPORT, NULL, NULL, SMARTPORT_BAUD, SMARTPORT_UART_MODE, portOptions);
+        telemetrySensorsReset(smartPortSensors, ARRAYLEN(smartPortSensors));
     }
 }
 
@@ -423,6 +422,185 @@ static bool smartPortShouldSendGPSData(void)
         || !ARMING_FLAG(WAS_EVER_ARMED));
 }
 
+static uint16_t smartPortGetDataId(uint16_t id)
+{
+    switch (id) {
+        case FSSP_DATAID_LONGITUDE:
+            return FSSP_DATAID_LATLONG;
+        case FSSP_DATAID_MODES:
+            return telemetryConfig()->frsky_use_legacy_gps_mode_sensor_ids ? FSSP_DATAID_LEGACY_MODES : id;
+        case FSSP_DATAID_GNSS:
+            return telemetryConfig()->frsky_use_legacy_gps_mode_sensor_ids ? FSSP_DATAID_LEGACY_GNSS : id;
+        default:
+            return id;
+    }
+}
+
+static bool smartPortReadSensor(const telemetrySensor_t *sensor, int32_t *value)
+{
+    switch (sensor->id) {
+        case FSSP_DATAID_VFAS:
+            if (isBatteryVoltageConfigured()) {
+                *value = telemetryConfig()->report_cell_voltage ? getBatteryAverageCellVoltage() : getBatteryVoltage();
+                return true;
+            }
+            break;
+        case FSSP_DATAID_CURRENT:
+            if (isAmperageConfigured()) {
+                *value = getAmperage() / 10; // given in 10mA steps, unknown requested unit
+                return true;
+            }
+            break;
+        //case FSSP_DATAID_RPM:
+        case FSSP_DATAID_ALTITUDE:
+            if (sensors(SENSOR_BARO)) {
+                *value = getEstimatedActualPosition(Z); // unknown given unit, requested 100 = 1 meter
+                return true;
+            }
+            break;
+        case FSSP_DATAID_FUEL:
+            if (telemetryConfig()->smartportFuelUnit == SMARTPORT_FUEL_UNIT_PERCENT) {
+                *value = calculateBatteryPercentage(); // Show remaining battery % if smartport_fuel_percent=ON
+                return true;
+            } else if (isAmperageConfigured()) {
+                *value = (telemetryConfig()->smartportFuelUnit == SMARTPORT_FUEL_UNIT_MAH ? getMAhDrawn() : getMWhDrawn());
+                return true;
+            }
+            break;
+        //case FSSP_DATAID_ADC1:
+        //case FSSP_DATAID_ADC2:
+        //case FSSP_DATAID_CAP_USED:
+        case FSSP_DATAID_VARIO:
+            if (sensors(SENSOR_BARO)) {
+                *value = lrintf(getEstimatedActualVelocity(Z)); // unknown given unit but requested in 100 = 1m/s
+                return true;
+            }
+            break;
+        case FSSP_DATAID_HEADING:
+            *value = attitude.values.yaw * 10; // given in 10*deg, requested in 10000 = 100 deg
+            return true;
+        case FSSP_DATAID_PITCH:
+            if (telemetryConfig()->frsky_pitch_roll) {
+                *value = attitude.values.pitch; // given in 10*deg
+                return true;
+            }
+            break;
+        case FSSP_DATAID_ROLL:
+            if (telemetryConfig()->frsky_pitch_roll) {
+                *value = attitude.values.roll; // given in 10*deg
+                return true;
+            }
+            break;
+        case FSSP_DATAID_ACCX:
+            if (!telemetryConfig()->frsky_pitch_roll) {
+                *value = lrintf(100 * acc.accADCf[X]);
+                return true;
+            }
+            break;
+        case FSSP_DATAID_ACCY:
+            if (!telemetryConfig()->frsky_pitch_roll) {
+                *value = lrintf(100 * acc.accADCf[Y]);
+                return true;
+            }
+            break;
+        case FSSP_DATAID_ACCZ:
+            if (!telemetryConfig()->frsky_pitch_roll) {
+                *value = lrintf(100 * acc.accADCf[Z]);
+                return true;
+            }
+            break;
+        case FSSP_DATAID_MODES:
+            *value = frskyGetFlightMode();
+            return true;
+#ifdef USE_GPS
+        case FSSP_DATAID_GNSS:
+            if (smartPortShouldSendGPSData()) {
+                *value = frskyGetGPSState();
+                return true;
+            }
+            break;
+        case FSSP_DATAID_SPEED:
+            if (smartPortShouldSendGPSData()) {
+                //convert to knots: 1cm/s = 0.0194384449 knots
+                //Speed should be sent in knots/1000 (GPS speed is in cm/s)
+                *value = gpsSol.groundSpeed * 1944 / 100;
+                return true;
+            }
+            break;
+        case FSSP_DATAID_LATLONG:
+        case FSSP_DATAID_LONGITUDE:
+            if (smartPortShouldSendGPSData()) {
+                uint32_t tmpui = 0;
+                // the same ID is sent for longitude and latitude,
+                // the MSB of the sent uint32_t helps FrSky keep track
+                if (sensor->id == FSSP_DATAID_LONGITUDE) {
+                    tmpui = abs(gpsSol.llh.lon);  // now we have unsigned value and one bit to spare
+                    tmpui = (tmpui + tmpui / 2) / 25 | 0x80000000;  // 6/100 = 1.5/25, division by power of 2 is fast
+                    if (gpsSol.llh.lon < 0) tmpui |= 0x40000000;
+                }
+                else {
+                    tmpui = abs(gpsSol.llh.lat);  // now we have unsigned value and one bit to spare
+                    tmpui = (tmpui + tmpui / 2) / 25;  // 6/100 = 1.5/25, division by power of 2 is fast
+                    if (gpsSol.llh.lat < 0) tmpui |= 0x40000000;
+                }
+                *value = tmpui;
+                return true;
+            }
+            break;
+        case FSSP_DATAID_HOME_DIST:
+            if (smartPortShouldSendGPSData()) {
+                *value = GPS_distanceToHome;
+                return true;
+            }
+            break;
+        case FSSP_DATAID_GPS_ALT:
+            if (smartPortShouldSendGPSData()) {
+                *value = gpsSol.llh.alt; // cm
+                return true;
+            }
+            break;
+        case FSSP_DATAID_FPV:
+            if (smartPortShouldSendGPSData()) {
+                *value = gpsSol.groundCourse; // given in 10*deg
+                return true;
+            }
+            break;
+        case FSSP_DATAID_AZIMUTH:
+            if (smartPortShouldSendGPSData()) {
+                int16_t h = GPS_directionToHome;
+                if (h < 0) {
+                    h += 360;
+                }
+                if(h >= 180)
+                    h = h - 180;
+                else
+                    h = h + 180;
+                *value = h * 10; // given in 10*deg
+                return true;
+            }
+            break;
+#endif
+        case FSSP_DATAID_A4:
+            if (isBatteryVoltageConfigured()) {
+                *value = getBatteryAverageCellVoltage();
+                return true;
+            }
+            break;
+        case FSSP_DATAID_ASPD:
+#ifdef USE_PITOT
+            if (sensors(SENSOR_PITOT) && pitotIsHealthy()) {
+                *value = getAirspeedEstimate() * 0.194384449f; // cm/s to knots*1
+                return true;
+            }
+#endif
+            break;
+        default:
+            break;
+    }
+
+    return false;
+}
+
 void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clearToSend, const uint32_t *requestTimeout)
 {
     if (payload) {
@@ -460,188 +638,18 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
         }
 #endif
 
-        // we can send back any data we want, our table keeps track of the order and frequency of each data type we send
-        uint16_t id = frSkyDataIdTable[smartPortIdCnt];
-        if (id == 0) { // end of table reached, loop back
-            smartPortIdCnt = 0;
-            id = frSkyDataIdTable[smartPortIdCnt];
-        }
-        smartPortIdCnt++;
-
-        switch (id) {
-            case FSSP_DATAID_VFAS:
-                if (isBatteryVoltageConfigured()) {
-                    uint16_t vfasVoltage = telemetryConfig()->report_cell_voltage ? getBatteryAverageCellVoltage() : getBatteryVoltage();
-                    smartPortSendPackage(id, vfasVoltage);
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_CURRENT:
-                if (isAmperageConfigured()) {
-                    smartPortSendPackage(id, getAmperage() / 10); // given in 10mA steps, unknown requested unit
-                    *clearToSend = false;
-                }
-                break;
-            //case FSSP_DATAID_RPM:
-            case FSSP_DATAID_ALTITUDE:
-                if (sensors(SENSOR_BARO)) {
-                    smartPortSendPackage(id, getEstimatedActualPosition(Z)); // unknown given unit, requested 100 = 1 meter
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_FUEL:
-                if (telemetryConfig()->smartportFuelUnit == SMARTPORT_FUEL_UNIT_PERCENT) {
-                    smartPortSendPackage(id, calculateBatteryPercentage()); // Show remaining battery % if smartport_fuel_percent=ON
-                    *clearToSend = false;
-                } else if (isAmperageConfigured()) {
-                    smartPortSendPackage(id, (telemetryConfig()->smartportFuelUnit == SMARTPORT_FUEL_UNIT_MAH ? getMAhDrawn() : getMWhDrawn()));
-                    *clearToSend = false;
-                }
-                break;
-            //case FSSP_DATAID_ADC1:
-            //case FSSP_DATAID_ADC2:
-            //case FSSP_DATAID_CAP_USED:
-            case FSSP_DATAID_VARIO:
-                if (sensors(SENSOR_BARO)) {
-                    smartPortSendPackage(id, lrintf(getEstimatedActualVelocity(Z))); // unknown given unit but requested in 100 = 1m/s
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_HEADING:
-                smartPortSendPackage(id, attitude.values.yaw * 10); // given in 10*deg, requested in 10000 = 100 deg
-                *clearToSend = false;
-                break;
-            case FSSP_DATAID_PITCH:
-                if (telemetryConfig()->frsky_pitch_roll) {
-                    smartPortSendPackage(id, attitude.values.pitch); // given in 10*deg
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_ROLL:
-                if (telemetryConfig()->frsky_pitch_roll) {
-                    smartPortSendPackage(id, attitude.values.roll); // given in 10*deg
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_ACCX:
-                if (!telemetryConfig()->frsky_pitch_roll) {
-                    smartPortSendPackage(id, lrintf(100 * acc.accADCf[X]));
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_ACCY:
-                if (!telemetryConfig()->frsky_pitch_roll) {
-                    smartPortSendPackage(id, lrintf(100 * acc.accADCf[Y]));
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_ACCZ:
-                if (!telemetryConfig()->frsky_pitch_roll) {
-                    smartPortSendPackage(id, lrintf(100 * acc.accADCf[Z]));
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_MODES:
-                {
-                    if (telemetryConfig()->frsky_use_legacy_gps_mode_sensor_ids)
-                        id = FSSP_DATAID_LEGACY_MODES;
-
-                    smartPortSendPackage(id, frskyGetFlightMode());
-                    *clearToSend = false;
-                    break;
-                }
-#ifdef USE_GPS
-            case FSSP_DATAID_GNSS:
-                {
-                    if (telemetryConfig()->frsky_use_legacy_gps_mode_sensor_ids)
-                        id = FSSP_DATAID_LEGACY_GNSS;
-
-                    if (smartPortShouldSendGPSData()) {
-                        smartPortSendPackage(id, frskyGetGPSState());
-                        *clearToSend = false;
-                    }
-                    break;
-                }
-            case FSSP_DATAID_SPEED:
-                if (smartPortShouldSendGPSData()) {
-                    //convert to knots: 1cm/s = 0.0194384449 knots
-                    //Speed should be sent in knots/1000 (GPS speed is in cm/s)
-                    uint32_t tmpui = gpsSol.groundSpeed * 1944 / 100;
-                    smartPortSendPackage(id, tmpui);
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_LATLONG:
-                if (smartPortShouldSendGPSData()) {
-                    uint32_t tmpui = 0;
-                    // the same ID is sent twice, one for longitude, one for latitude
-                    // the MSB of the sent uint32_t helps FrSky keep track
-                    // the even/odd bit of our counter helps us keep track
-                    if (smartPortIdCnt & 1) {
-                        tmpui = abs(gpsSol.llh.lon);  // now we have unsigned value and one bit to spare
-                        tmpui = (tmpui + tmpui / 2) / 25 | 0x80000000;  // 6/100 = 1.5/25, division by power of 2 is fast
-                        if (gpsSol.llh.lon < 0) tmpui |= 0x40000000;
-                    }
-                    else {
-                        tmpui = abs(gpsSol.llh.lat);  // now we have unsigned value and one bit to spare
-                        tmpui = (tmpui + tmpui / 2) / 25;  // 6/100 = 1.5/25, division by power of 2 is fast
-                        if (gpsSol.llh.lat < 0) tmpui |= 0x40000000;
-                    }
-                    smartPortSendPackage(id, tmpui);
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_HOME_DIST:
-                if (smartPortShouldSendGPSData()) {
-                    smartPortSendPackage(id, GPS_distanceToHome);
-                     *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_GPS_ALT:
-                if (smartPortShouldSendGPSData()) {
-                    smartPortSendPackage(id, gpsSol.llh.alt); // cm
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_FPV:
-                if (smartPortShouldSendGPSData()) {
-                    smartPortSendPackage(id, gpsSol.groundCourse); // given in 10*deg
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_AZIMUTH:
-                if (smartPortShouldSendGPSData()) {
-                    int16_t h = GPS_directionToHome;
-                    if (h < 0) {
-                        h += 360;
-                    }
-                    if(h >= 180)
-                        h = h - 180;
-                    else
-                        h = h + 180;
-                    smartPortSendPackage(id, h *10); // given in 10*deg
-                    *clearToSend = false;
-                }
-                break;
-#endif
-            case FSSP_DATAID_A4:
-                if (isBatteryVoltageConfigured()) {
-                    smartPortSendPackage(id, getBatteryAverageCellVoltage());
-                    *clearToSend = false;
-                }
-                break;
-            case FSSP_DATAID_ASPD:
-#ifdef USE_PITOT
-                if (sensors(SENSOR_PITOT) && pitotIsHealthy()) {
-                    smartPortSendPackage(id, getAirspeedEstimate() * 0.194384449f); // cm/s to knots*1
-                    *clearToSend = false;
-                }
-#endif
-                break;
-            default:
-                break;
-                // if nothing is sent, hasRequest isn't cleared, we already incremented the counter, just loop back to the start
+        // we can send back any data we want, the scheduler picks the most stale and important value
+        const timeMs_t now = millis();
+        int32_t value;
+        telemetrySensor_t *sensor = telemetrySensorNext(smartPortSensors, ARRAYLEN(smartPortSensors), now, smartPortReadSensor, &value);
+        if (!sensor) {
+            // nothing available, hasRequest isn't cleared
+            return;
         }
+
+        smartPortSendPackage(smartPortGetDataId(sensor->id), value);
+        telemetrySensorMarkSent(sensor, value, now);
+        *clearToSend = false;
     }
 }
 
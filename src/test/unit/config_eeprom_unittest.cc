@@ -0,0 +1,237 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "config/config_eeprom.h"
+    #include "config/config_streamer.h"
+    #include "config/parameter_group.h"
+    #include "config/parameter_group_ids.h"
+
+    #include "drivers/system.h"
+    #include "drivers/time.h"
+
+    #include "fc/config.h"
+
+    typedef struct testSystemConfig_s {
+        uint32_t value;
+        uint8_t padding[60];
+    } testSystemConfig_t;
+
+    typedef struct testProfileConfig_s {
+        uint32_t value;
+        uint8_t padding[200];
+    } testProfileConfig_t;
+
+    PG_DECLARE(testSystemConfig_t, testSystemConfig);
+    PG_REGISTER(testSystemConfig_t, testSystemConfig, PG_RESERVED_FOR_TESTING_1, 0);
+
+    PG_DECLARE_PROFILE(testProfileConfig_t, testProfileConfig);
+    PG_REGISTER_PROFILE(testProfileConfig_t, testProfileConfig, PG_RESERVED_FOR_TESTING_2, 0);
+
+    static int failureCount;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static uint32_t alignedSize(uint32_t size)
+{
+    return (size + CONFIG_STREAMER_BUFFER_SIZE - 1) / CONFIG_STREAMER_BUFFER_SIZE * CONFIG_STREAMER_BUFFER_SIZE;
+}
+
+static void setValues(uint32_t systemValue, uint32_t profileValue)
+{
+    testSystemConfigMutable()->value = systemValue;
+    testProfileConfig_Storage[1].value = profileValue;
+}
+
+static void save(void)
+{
+    writeConfigToEEPROM();
+    EXPECT_EQ(0, failureCount);
+}
+
+// Clears the PGs in RAM and loads them back from the stored copy
+static void reload(void)
+{
+    memset(testSystemConfigMutable(), 0, sizeof(testSystemConfig_t));
+    memset(testProfileConfig_Storage, 0, sizeof(testProfileConfig_Storage));
+    EXPECT_TRUE(isEEPROMContentValid());
+    EXPECT_TRUE(loadEEPROM());
+}
+
+// Starts from blank memory, returns the size of a full copy without deltas
+static uint32_t setupFullCopy(void)
+{
+    memset(eepromData, 0, sizeof(eepromData));
+    failureCount = 0;
+    setValues(100, 200);
+    save();
+    return getEEPROMConfigSize();
+}
+
+TEST(ConfigEepromTest, AppendsDelta)
+{
+    const uint32_t fullSize = setupFullCopy();
+
+    setValues(101, 200);
+    save();
+    const uint32_t deltaSize = getEEPROMConfigSize();
+    EXPECT_GT(deltaSize, alignedSize(fullSize));
+    // Only the changed system PG is in the block
+    EXPECT_LT(deltaSize - fullSize, sizeof(testProfileConfig_t));
+
+    // Nothing changed, nothing written
+    save();
+    EXPECT_EQ(deltaSize, getEEPROMConfigSize());
+
+    reload();
+    EXPECT_EQ(101u, testSystemConfig()->value);
+    EXPECT_EQ(200u, testProfileConfig_Storage[1].value);
+}
+
+TEST(ConfigEepromTest, ReplaysDeltasInOrder)
+{
+    setupFullCopy();
+
+    setValues(1, 200);
+    save();
+    setValues(2, 201);
+    save();
+    setValues(3, 201);
+    save();
+
+    reload();
+    EXPECT_EQ(3u, testSystemConfig()->value);
+    EXPECT_EQ(201u, testProfileConfig_Storage[1].value);
+}
+
+TEST(ConfigEepromTest, IgnoresStaleGeneration)
+{
+    const uint32_t fullSize = setupFullCopy();
+
+    setValues(555, 200);
+    save();
+    const uint32_t blockStart = alignedSize(fullSize);
+    const uint32_t blockEnd = alignedSize(getEEPROMConfigSize());
+    uint8_t staleBlock[512];
+    ASSERT_LE(blockEnd - blockStart, sizeof(staleBlock));
+    memcpy(staleBlock, eepromData + blockStart, blockEnd - blockStart);
+
+    // Anything programmed where the next block goes forces a full rewrite with a new generation
+    eepromData[blockEnd] = 0;
+    setValues(556, 200);
+    save();
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+
+    // A valid block of the previous generation right behind the new copy
+    memcpy(eepromData + blockStart, staleBlock, blockEnd - blockStart);
+    reload();
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+    EXPECT_EQ(556u, testSystemConfig()->value);
+}
+
+TEST(ConfigEepromTest, AppendsBeforeStaleSector)
+{
+    const uint32_t fullSize = setupFullCopy();
+
+    // A later sector of the partition still holding blocks of an older, larger config
+    memset(eepromData + EEPROM_SIZE / 2, 0, EEPROM_SIZE / 2);
+
+    setValues(101, 200);
+    save();
+    EXPECT_GT(getEEPROMConfigSize(), alignedSize(fullSize));
+
+    reload();
+    EXPECT_EQ(101u, testSystemConfig()->value);
+}
+
+TEST(ConfigEepromTest, RewritesAfterTornBlock)
+{
+    const uint32_t fullSize = setupFullCopy();
+
+    setValues(1, 200);
+    save();
+    const uint32_t firstDeltaEnd = getEEPROMConfigSize();
+
+    setValues(2, 200);
+    save();
+    const uint32_t blockStart = alignedSize(firstDeltaEnd);
+    const uint32_t blockEnd = alignedSize(getEEPROMConfigSize());
+
+    // Power lost halfway through programming the second block
+    const uint32_t tornAt = alignedSize((blockStart + blockEnd) / 2);
+    memset(eepromData + tornAt, CONFIG_ERASED_BYTE, blockEnd - tornAt);
+
+    reload();
+    EXPECT_EQ(firstDeltaEnd, getEEPROMConfigSize());
+    EXPECT_EQ(1u, testSystemConfig()->value);
+
+    // The next block can't go over the partly programmed one
+    setValues(3, 200);
+    save();
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+
+    reload();
+    EXPECT_EQ(3u, testSystemConfig()->value);
+    EXPECT_EQ(200u, testProfileConfig_Storage[1].value);
+}
+
+TEST(ConfigEepromTest, CompactsWhenFull)
+{
+    const uint32_t fullSize = setupFullCopy();
+    bool compacted = false;
+    uint32_t previousSize = fullSize;
+
+    for (uint32_t i = 1; i < EEPROM_SIZE / sizeof(testProfileConfig_t) + 2 && !compacted; i++) {
+        setValues(100 + i, 200 + i);
+        save();
+
+        compacted = getEEPROMConfigSize() < previousSize;
+        previousSize = getEEPROMConfigSize();
+
+        reload();
+        EXPECT_EQ(100 + i, testSystemConfig()->value);
+        EXPECT_EQ(200 + i, testProfileConfig_Storage[1].value);
+    }
+
+    EXPECT_TRUE(compacted);
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+}
+
+// STUBS
+
+extern "C" {
+
+timeUs_t micros(void)
+{
+    return 0;
+}
+
+void failureMode(failureMode_e mode)
+{
+    UNUSED(mode);
+    failureCount++;
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+
+extern "C" {
+    #include "common/crc.h"
+    #include "common/streambuf.h"
+}
+
+#include "gtest/gtest.h"
+
+// Bitwise references the lookup tables replaced
+
+static uint16_t crc16_ccitt_bitwise(uint16_t crc, uint8_t a)
+{
+    crc ^= (uint16_t)a << 8;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint8_t crc8_dvb_s2_bitwise(uint8_t crc, uint8_t a)
+{
+    crc ^= a;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x80) ? (crc << 1) ^ 0xD5 : crc << 1;
+    }
+    return crc;
+}
+
+static const uint8_t checkData[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+TEST(CrcTest, Crc16CcittMatchesBitwise)
+{
+    for (uint32_t crc = 0; crc <= UINT16_MAX; crc++) {
+        for (uint32_t a = 0; a <= UINT8_MAX; a++) {
+            ASSERT_EQ(crc16_ccitt_bitwise(crc, a), crc16_ccitt(crc, a)) << "crc " << crc << " byte " << a;
+        }
+    }
+}
+
+TEST(CrcTest, Crc8DvbS2MatchesBitwise)
+{
+    for (uint32_t crc = 0; crc <= UINT8_MAX; crc++) {
+        for (uint32_t a = 0; a <= UINT8_MAX; a++) {
+            ASSERT_EQ(crc8_dvb_s2_bitwise(crc, a), crc8_dvb_s2(crc, a)) << "crc " << crc << " byte " << a;
+        }
+    }
+}
+
+TEST(CrcTest, CheckValues)
+{
+    // Catalogue check values for "123456789": CRC-16/XMODEM and CRC-8/DVB-S2
+    EXPECT_EQ(0x31C3, crc16_ccitt_update(0, checkData, sizeof(checkData)));
+    EXPECT_EQ(0xBC, crc8_dvb_s2_update(0, checkData, sizeof(checkData)));
+}
+
+TEST(CrcTest, SbufAppend)
+{
+    uint8_t buffer[sizeof(checkData) + 2];
+    sbuf_t sbuf;
+
+    sbufInit(&sbuf, buffer, buffer + sizeof(buffer));
+    sbufWriteData(&sbuf, checkData, sizeof(checkData));
+    crc8_dvb_s2_sbuf_append(&sbuf, buffer);
+    EXPECT_EQ(0xBC, buffer[sizeof(checkData)]);
+
+    sbufInit(&sbuf, buffer, buffer + sizeof(buffer));
+    sbufWriteData(&sbuf, checkData, sizeof(checkData));
+    crc16_ccitt_sbuf_append(&sbuf, buffer);
+    EXPECT_EQ(0x31C3, buffer[sizeof(checkData)] | (buffer[sizeof(checkData) + 1] << 8));
+}
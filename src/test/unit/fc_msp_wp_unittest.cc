@@ -0,0 +1,111 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/streambuf.h"
+
+    #include "fc/fc_msp_wp.h"
+
+    #include "navigation/navigation.h"
+
+    static std::vector<uint8_t> storedWaypoints;
+    static uint8_t rejectedWpNo;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static std::vector<uint8_t> makeBatch(uint8_t firstWpNo, unsigned count)
+{
+    std::vector<uint8_t> payload(1 + count * MSP_WP_BATCH_RECORD_SIZE);
+    sbuf_t buf;
+    sbufInit(&buf, payload.data(), payload.data() + payload.size());
+
+    sbufWriteU8(&buf, firstWpNo);
+    for (unsigned i = 0; i < count; i++) {
+        navWaypoint_t wp = { };
+        wp.action = NAV_WP_ACTION_WAYPOINT;
+        wp.flag = (i == count - 1) ? NAV_WP_FLAG_LAST : 0;
+        mspSerializeWaypoint(&buf, &wp);
+    }
+    return payload;
+}
+
+static mspResult_e sendBatch(std::vector<uint8_t> payload)
+{
+    sbuf_t buf;
+    sbufInit(&buf, payload.data(), payload.data() + payload.size());
+    return mspFcWaypointBatchInCommand(&buf, payload.size());
+}
+
+TEST(MspWaypointTest, BatchAccepted)
+{
+    storedWaypoints.clear();
+    rejectedWpNo = 0;
+
+    EXPECT_EQ(MSP_RESULT_ACK, sendBatch(makeBatch(1, 5)));
+    EXPECT_EQ(std::vector<uint8_t>({ 1, 2, 3, 4, 5 }), storedWaypoints);
+}
+
+TEST(MspWaypointTest, BatchFailsOnFirstRejectedWaypoint)
+{
+    storedWaypoints.clear();
+    rejectedWpNo = 3;
+
+    // The upload must not be acknowledged, and nothing past the rejected waypoint is tried
+    EXPECT_EQ(MSP_RESULT_ERROR, sendBatch(makeBatch(1, 5)));
+    EXPECT_EQ(std::vector<uint8_t>({ 1, 2 }), storedWaypoints);
+}
+
+TEST(MspWaypointTest, BatchRejectsBadRange)
+{
+    storedWaypoints.clear();
+    rejectedWpNo = 0;
+
+    EXPECT_EQ(MSP_RESULT_ERROR, sendBatch(makeBatch(0, 1)));
+    EXPECT_EQ(MSP_RESULT_ERROR, sendBatch(makeBatch(NAV_MAX_WAYPOINTS, 2)));
+
+    std::vector<uint8_t> truncated = makeBatch(1, 2);
+    truncated.pop_back();
+    EXPECT_EQ(MSP_RESULT_ERROR, sendBatch(truncated));
+
+    EXPECT_TRUE(storedWaypoints.empty());
+}
+
+// STUBS
+
+extern "C" {
+
+bool setWaypoint(uint8_t wpNumber, const navWaypoint_t *wpData)
+{
+    UNUSED(wpData);
+    if (wpNumber == rejectedWpNo) {
+        return false;
+    }
+    storedWaypoints.push_back(wpNumber);
+    return true;
+}
+
+int getWaypointCount(void) { return storedWaypoints.size(); }
+void getWaypoint(uint8_t wpNumber, navWaypoint_t *wpData) { UNUSED(wpNumber); UNUSED(wpData); }
+
+}
@@ -19,7 +19,12 @@
 
 #include <limits.h>
 
+#include <chrono>
+#include <cstdio>
+
 extern "C" {
+    #include "common/quaternion.h"
+
     #include "sensors/gyro.h"
     #include "sensors/compass.h"
     #include "sensors/acceleration.h"
@@ -85,6 +90,70 @@ TEST(FlightImuTest, TestEulerAngleCalculation)
     EXPECT_NEAR(attitude.values.yaw, 2700, 1);
 }
 
+TEST(FlightImuTest, TestVectorTransformMatchesQuaternionRotation)
+{
+    const fpVector3_t v = { .v = { 120.0f, -35.0f, 980.0f } };
+
+    for (int roll = -1800; roll < 1800; roll += 150) {
+        for (int pitch = -850; pitch <= 850; pitch += 170) {
+            for (int yaw = 0; yaw < 3600; yaw += 300) {
+                imuComputeQuaternionFromRPY(roll, pitch, yaw);
+
+                // Reference: rotate with the quaternion directly, including the NED -> NEU flip
+                fpVector3_t expectedEF;
+                quaternionRotateVectorInv(&expectedEF, &v, &orientation);
+                expectedEF.y = -expectedEF.y;
+
+                fpVector3_t ef = v;
+                imuTransformVectorBodyToEarth(&ef);
+                EXPECT_NEAR(ef.x, expectedEF.x, 1e-2f);
+                EXPECT_NEAR(ef.y, expectedEF.y, 1e-2f);
+                EXPECT_NEAR(ef.z, expectedEF.z, 1e-2f);
+
+                // And back to body frame
+                imuTransformVectorEarthToBody(&ef);
+                EXPECT_NEAR(ef.x, v.x, 1e-2f);
+                EXPECT_NEAR(ef.y, v.y, 1e-2f);
+                EXPECT_NEAR(ef.z, v.z, 1e-2f);
+            }
+        }
+    }
+}
+
+// Not a pass/fail check, timings depend on the host. Reports the cost per
+// call of both rotation paths so changes to them can be compared.
+TEST(FlightImuTest, BenchmarkVectorTransform)
+{
+    const int iterations = 1000000;
+    fpVector3_t v = { .v = { 120.0f, -35.0f, 980.0f } };
+    float sink = 0;
+
+    imuComputeQuaternionFromRPY(300, -200, 1200);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fpVector3_t ef;
+        quaternionRotateVectorInv(&ef, &v, &orientation);
+        sink += ef.x;
+        v.x += 1e-3f;
+    }
+    const double quaternionNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fpVector3_t ef = v;
+        imuTransformVectorBodyToEarth(&ef);
+        sink += ef.x;
+        v.x -= 1e-3f;
+    }
+    const double matrixNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    printf("quaternion rotation: %.1f ns/call, rotation matrix: %.1f ns/call\n", quaternionNs, matrixNs);
+    RecordProperty("quaternion_ns", (int)(quaternionNs * 10));
+    RecordProperty("matrix_ns", (int)(matrixNs * 10));
+    EXPECT_TRUE(sink == sink);
+}
+
 // STUBS
 
 extern "C" {
@@ -139,4 +208,5 @@ void resetHeadingHoldTarget(int16_t heading)
     UNUSED(heading);
 }
 bool isGPSHeadingValid(void) { return true; }
+bool isMixerTransitionMixing;
 }
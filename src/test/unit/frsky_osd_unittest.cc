@@ -0,0 +1,263 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/uvarint.h"
+
+    #include "drivers/time.h"
+
+    #include "io/frsky_osd.h"
+    #include "io/serial.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Command IDs from the FrSky OSD protocol
+#define CMD_TRANSACTION_BEGIN_RESET_DRAWING  19
+#define CMD_TRANSACTION_COMMIT               17
+#define CMD_SET_STROKE_COLOR                 22
+#define CMD_CONTEXT_PUSH                     100
+#define CMD_CONTEXT_POP                      101
+
+// The drawing state stack in frsky_osd.c holds this many levels, the
+// bottom one included
+#define DRAWING_STATE_STACK_SIZE             4
+
+static std::vector<uint8_t> serialOutput;
+
+static void openOsd(void)
+{
+    EXPECT_TRUE(frskyOSDInit(VIDEO_SYSTEM_AUTO));
+}
+
+// Starts a transaction with a known drawing state
+static void begin(void)
+{
+    serialOutput.clear();
+    frskyOSDBeginTransaction(FRSKY_OSD_TRANSACTION_OPT_RESET_DRAWING);
+}
+
+// Commits the transaction and returns the commands in it, without the
+// begin and commit commands
+static std::vector<uint8_t> commit(void)
+{
+    frskyOSDCommitTransaction();
+
+    // '$' 'A' <uvarint length> <payload> <crc>
+    EXPECT_GE(serialOutput.size(), 4u);
+    EXPECT_EQ('$', serialOutput[0]);
+    EXPECT_EQ('A', serialOutput[1]);
+    uint32_t length;
+    const int lengthSize = uvarintDecode(&length, &serialOutput[2], serialOutput.size() - 2);
+    EXPECT_GT(lengthSize, 0);
+    EXPECT_EQ(2 + lengthSize + length + 1, serialOutput.size());
+
+    std::vector<uint8_t> payload(serialOutput.begin() + 2 + lengthSize, serialOutput.begin() + 2 + lengthSize + length);
+    EXPECT_EQ(CMD_TRANSACTION_BEGIN_RESET_DRAWING, payload.front());
+    EXPECT_EQ(CMD_TRANSACTION_COMMIT, payload.back());
+    return std::vector<uint8_t>(payload.begin() + 1, payload.end() - 1);
+}
+
+TEST(FrSkyOSDTest, DropsUnchangedState)
+{
+    openOsd();
+
+    begin();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+
+    const std::vector<uint8_t> expected = {
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE,
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_BLACK,
+    };
+    EXPECT_EQ(expected, commit());
+}
+
+TEST(FrSkyOSDTest, PopRestoresState)
+{
+    openOsd();
+
+    begin();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDContextPush();
+    // Inherited from the outer level
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+    frskyOSDContextPush();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_GRAY);
+    frskyOSDContextPop();
+    // Back to black
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+    frskyOSDContextPop();
+    // Back to white
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+
+    const std::vector<uint8_t> expected = {
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE,
+        CMD_CONTEXT_PUSH,
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_BLACK,
+        CMD_CONTEXT_PUSH,
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_GRAY,
+        CMD_CONTEXT_POP,
+        CMD_CONTEXT_POP,
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_BLACK,
+    };
+    EXPECT_EQ(expected, commit());
+}
+
+TEST(FrSkyOSDTest, OverflowForgetsState)
+{
+    openOsd();
+
+    begin();
+    std::vector<uint8_t> expected;
+
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    expected.insert(expected.end(), { CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE });
+
+    // Fill the stack, then go two levels past it
+    const int pushes = DRAWING_STATE_STACK_SIZE - 1 + 2;
+    for (int i = 0; i < pushes; i++) {
+        frskyOSDContextPush();
+        expected.push_back(CMD_CONTEXT_PUSH);
+    }
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+    expected.insert(expected.end(), { CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_BLACK });
+
+    // Levels past the stack weren't saved, the state after popping them
+    // is unknown and gets sent again
+    for (int i = 0; i < 2; i++) {
+        frskyOSDContextPop();
+        frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+        expected.insert(expected.end(), { CMD_CONTEXT_POP, CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE });
+    }
+
+    // The saved levels are still there, down to the bottom
+    for (int i = 0; i < DRAWING_STATE_STACK_SIZE - 1; i++) {
+        frskyOSDContextPop();
+        frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+        expected.push_back(CMD_CONTEXT_POP);
+    }
+
+    EXPECT_EQ(expected, commit());
+}
+
+TEST(FrSkyOSDTest, UnderflowForgetsState)
+{
+    openOsd();
+
+    begin();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    // Pops a level pushed before the transaction, unknown here
+    frskyOSDContextPop();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+
+    const std::vector<uint8_t> expected = {
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE,
+        CMD_CONTEXT_POP,
+        CMD_SET_STROKE_COLOR, FRSKY_OSD_COLOR_WHITE,
+    };
+    EXPECT_EQ(expected, commit());
+}
+
+// STUBS
+
+extern "C" {
+
+static serialPortConfig_t portConfig;
+static serialPort_t port;
+static uint16_t gridEntry;
+
+const uint32_t baudRates[BAUD_MAX + 1] = { 0 };
+
+void osdCharacterGridBufferClear(void)
+{
+}
+
+uint16_t *osdCharacterGridBufferGetEntryPtr(unsigned x, unsigned y)
+{
+    UNUSED(x);
+    UNUSED(y);
+    return &gridEntry;
+}
+
+timeMs_t millis(void)
+{
+    return 0;
+}
+
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function)
+{
+    UNUSED(function);
+    return &portConfig;
+}
+
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr rxCallback,
+    void *rxCallbackData, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier);
+    UNUSED(function);
+    UNUSED(rxCallback);
+    UNUSED(rxCallbackData);
+    UNUSED(baudrate);
+    UNUSED(mode);
+    UNUSED(options);
+    return &port;
+}
+
+void serialWrite(serialPort_t *instance, uint8_t ch)
+{
+    UNUSED(instance);
+    serialOutput.push_back(ch);
+}
+
+uint32_t serialTxBytesFree(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 1;
+}
+
+uint32_t serialRxBytesWaiting(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 0;
+}
+
+uint8_t serialRead(serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 0;
+}
+
+void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate)
+{
+    UNUSED(instance);
+    UNUSED(baudRate);
+}
+
+}
@@ -97,4 +97,183 @@ TEST(GPSUbloxTest, navSigStructureSizes) {
     EXPECT_TRUE(sizeof(ubx_nav_svinfo_channel) == 12);
 
     EXPECT_TRUE(sizeof(ubx_nav_svinfo) == (8 + (12 * UBLOX_MAX_SIGNALS)));
-}
\ No newline at end of file
+}
+
+static int handlerCalls;
+static uint8_t lastClass;
+static uint16_t lastLength;
+static ubx_nav_pvt lastPvt;
+
+static void testHandlePvt(const void *payload, uint16_t length)
+{
+    handlerCalls++;
+    lastClass = CLASS_NAV;
+    lastLength = length;
+    memcpy(&lastPvt, payload, sizeof(lastPvt));
+}
+
+static void testHandleAck(const void *payload, uint16_t length)
+{
+    UNUSED(payload);
+    handlerCalls++;
+    lastClass = CLASS_ACK;
+    lastLength = length;
+}
+
+static void testHandleValset(const void *payload, uint16_t length)
+{
+    UNUSED(payload);
+    handlerCalls++;
+    lastClass = CLASS_CFG;
+    lastLength = length;
+}
+
+static const ubxMessageHandler_t testHandlers[] = {
+    { CLASS_NAV, MSG_PVT,       sizeof(ubx_nav_pvt),    testHandlePvt },
+    { CLASS_ACK, MSG_ACK_ACK,   sizeof(ubx_ack_ack),    testHandleAck },
+    { CLASS_CFG, 0x8A,          4,                      testHandleValset },
+};
+
+#define TEST_HANDLER_COUNT (sizeof(testHandlers) / sizeof(testHandlers[0]))
+
+static uint8_t rxBuffer[UBLOX_BUFFER_SIZE];
+
+static int buildFrame(uint8_t *frame, uint8_t msgClass, uint8_t msgId, const void *payload, uint16_t length)
+{
+    frame[0] = PREAMBLE1;
+    frame[1] = PREAMBLE2;
+    frame[2] = msgClass;
+    frame[3] = msgId;
+    frame[4] = length & 0xFF;
+    frame[5] = length >> 8;
+    memcpy(frame + 6, payload, length);
+    ublox_update_checksum(frame + 2, length + 4, &frame[length + 6], &frame[length + 7]);
+    return length + 8;
+}
+
+// Feed a stream and count the results
+static void replay(ubxFrameParser_t *parser, const uint8_t *stream, int size, int *results)
+{
+    for (int i = 0; i < size; i++) {
+        results[ubloxFrameParserFeed(parser, stream[i])]++;
+    }
+}
+
+static void resetParser(ubxFrameParser_t *parser)
+{
+    handlerCalls = 0;
+    lastLength = 0;
+    memset(rxBuffer, 0, sizeof(rxBuffer));
+    ubloxFrameParserInit(parser, testHandlers, TEST_HANDLER_COUNT, rxBuffer, sizeof(rxBuffer));
+}
+
+TEST(GPSUbloxTest, FrameParserFindsHandlerByClassAndId)
+{
+    EXPECT_EQ(&testHandlers[0], ubloxFindMessageHandler(testHandlers, TEST_HANDLER_COUNT, CLASS_NAV, MSG_PVT));
+    EXPECT_EQ(&testHandlers[1], ubloxFindMessageHandler(testHandlers, TEST_HANDLER_COUNT, CLASS_ACK, MSG_ACK_ACK));
+    // Same id, other class
+    EXPECT_EQ(NULL, ubloxFindMessageHandler(testHandlers, TEST_HANDLER_COUNT, CLASS_MON, MSG_PVT));
+    EXPECT_EQ(NULL, ubloxFindMessageHandler(testHandlers, TEST_HANDLER_COUNT, CLASS_NAV, MSG_ACK_ACK));
+}
+
+TEST(GPSUbloxTest, FrameParserReplaysStream)
+{
+    ubxFrameParser_t parser;
+    resetParser(&parser);
+
+    ubx_nav_pvt pvt = {};
+    pvt.longitude = 123456789;
+    pvt.latitude = -98765432;
+    pvt.satellites = 17;
+    pvt.fix_type = 3;
+
+    const uint8_t unknown[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const ubx_ack_ack ack = { CLASS_CFG, MSG_CFG_RATE };
+
+    uint8_t stream[512];
+    int size = 0;
+    // Leading garbage and a false preamble
+    stream[size++] = 0x00;
+    stream[size++] = PREAMBLE1;
+    stream[size++] = 0x00;
+    size += buildFrame(stream + size, CLASS_NAV, MSG_PVT, &pvt, 92);
+    size += buildFrame(stream + size, CLASS_NAV, 0x22, unknown, sizeof(unknown));
+    size += buildFrame(stream + size, CLASS_ACK, MSG_ACK_ACK, &ack, sizeof(ack));
+
+    int results[UBX_FRAME_ERROR + 1] = {};
+    replay(&parser, stream, size, results);
+
+    EXPECT_EQ(2, results[UBX_FRAME_DISPATCHED]);
+    EXPECT_EQ(1, results[UBX_FRAME_SKIPPED]);
+    EXPECT_EQ(0, results[UBX_FRAME_ERROR]);
+    EXPECT_EQ(2, handlerCalls);
+    EXPECT_EQ(CLASS_ACK, lastClass);
+    EXPECT_EQ(sizeof(ack), lastLength);
+
+    EXPECT_EQ(pvt.longitude, lastPvt.longitude);
+    EXPECT_EQ(pvt.latitude, lastPvt.latitude);
+    EXPECT_EQ(pvt.satellites, lastPvt.satellites);
+    EXPECT_EQ(pvt.fix_type, lastPvt.fix_type);
+
+    // Unhandled payload never reaches the receive buffer, ACK is the last thing stored
+    EXPECT_EQ(CLASS_CFG, rxBuffer[0]);
+    EXPECT_EQ(MSG_CFG_RATE, rxBuffer[1]);
+    EXPECT_EQ(0, rxBuffer[2]);
+}
+
+TEST(GPSUbloxTest, FrameParserExternalFrame)
+{
+    ubxFrameParser_t parser;
+    resetParser(&parser);
+
+    // CFG-VALSET enabling GLONASS, as generated by u-center 2. This is a
+    // frame sent to the receiver, not receiver output. It is here because
+    // its checksum comes from another encoder than buildFrame().
+    const uint8_t valset[] = {0xB5, 0x62, 0x06, 0x8A, 0x09, 0x00, 0x01, 0x01, 0x00, 0x00, 0x25, 0x00, 0x31, 0x10, 0x01, 0x02, 0xA7};
+
+    int results[UBX_FRAME_ERROR + 1] = {};
+    replay(&parser, valset, sizeof(valset), results);
+
+    EXPECT_EQ(1, results[UBX_FRAME_DISPATCHED]);
+    EXPECT_EQ(0, results[UBX_FRAME_ERROR]);
+    EXPECT_EQ(CLASS_CFG, lastClass);
+    EXPECT_EQ(9, lastLength);
+    EXPECT_FALSE(memcmp(valset + 6, rxBuffer, 9));
+}
+
+TEST(GPSUbloxTest, FrameParserRejectsBadFrames)
+{
+    ubxFrameParser_t parser;
+    resetParser(&parser);
+
+    const ubx_ack_ack ack = { CLASS_CFG, MSG_CFG_RATE };
+    uint8_t stream[128];
+    int size = 0;
+
+    // Corrupted checksum A and B
+    int frameSize = buildFrame(stream + size, CLASS_ACK, MSG_ACK_ACK, &ack, sizeof(ack));
+    stream[size + frameSize - 2] ^= 0xFF;
+    size += frameSize;
+    frameSize = buildFrame(stream + size, CLASS_ACK, MSG_ACK_ACK, &ack, sizeof(ack));
+    stream[size + frameSize - 1] ^= 0xFF;
+    size += frameSize;
+    // Too short to be an ACK, must not be dispatched
+    size += buildFrame(stream + size, CLASS_ACK, MSG_ACK_ACK, &ack, 1);
+    // Length larger than the receive buffer, parser must resync right away
+    stream[size++] = PREAMBLE1;
+    stream[size++] = PREAMBLE2;
+    stream[size++] = CLASS_NAV;
+    stream[size++] = MSG_PVT;
+    stream[size++] = 0xFF;
+    stream[size++] = 0xFF;
+    // Good frame
+    size += buildFrame(stream + size, CLASS_ACK, MSG_ACK_ACK, &ack, sizeof(ack));
+
+    int results[UBX_FRAME_ERROR + 1] = {};
+    replay(&parser, stream, size, results);
+
+    EXPECT_EQ(3, results[UBX_FRAME_ERROR]);
+    EXPECT_EQ(1, results[UBX_FRAME_SKIPPED]);
+    EXPECT_EQ(1, results[UBX_FRAME_DISPATCHED]);
+    EXPECT_EQ(1, handlerCalls);
+}
@@ -1,11 +1,17 @@
 #include "gtest/gtest.h"
 #include "unittest_macros.h"
 
+#include <chrono>
 #include <iostream>
 #include <string>
 
 extern "C" {
+#include "common/maths.h"
+#include "common/printf.h"
+#include "drivers/osd_symbols.h"
+#include "drivers/serial.h"
 #include "io/osd.h"
+#include "io/osd_utils.h"
 };
 
 
@@ -68,4 +74,123 @@ TEST(OSDTest, TestCentiNumber)
 
    EXPECT_EQ(1, 1);
 
-}
\ No newline at end of file
+}
+
+TEST(OSDTest, TestFormatInteger)
+{
+   char buf[16];
+
+   EXPECT_EQ(3, osdFormatInteger(buf, 5, 3, ' '));
+   EXPECT_STREQ("  5", buf);
+
+   EXPECT_EQ(3, osdFormatInteger(buf, -5, 3, ' '));
+   EXPECT_STREQ(" -5", buf);
+
+   EXPECT_EQ(4, osdFormatInteger(buf, 1234, 3, ' '));
+   EXPECT_STREQ("1234", buf);
+
+   EXPECT_EQ(2, osdFormatInteger(buf, 7, 2, '0'));
+   EXPECT_STREQ("07", buf);
+
+   EXPECT_EQ(3, osdFormatInteger(buf, -7, 3, '0'));
+   EXPECT_STREQ("-07", buf);
+
+   EXPECT_EQ(1, osdFormatInteger(buf, 0, 0, ' '));
+   EXPECT_STREQ("0", buf);
+
+   EXPECT_EQ(11, osdFormatInteger(buf, INT32_MIN, 3, ' '));
+   EXPECT_STREQ("-2147483648", buf);
+}
+
+TEST(OSDTest, TestUnitConversions)
+{
+   // Integer conversions must match the float macros they replace,
+   // except where float rounding lands just below a whole number.
+   for (int32_t value = -200000; value <= 200000; value += 7) {
+      EXPECT_NEAR(osdCentimetersToCentifeet(value), (int32_t)CENTIMETERS_TO_CENTIFEET(value), 1);
+      EXPECT_NEAR(osdCmsToCentiKph(value), (int32_t)CMSEC_TO_CENTIKPH(value), 1);
+      EXPECT_NEAR(osdCmsToCentiMph(value), (int32_t)CMSEC_TO_CENTIMPH(value), 1);
+      EXPECT_NEAR(osdCmsToCentiKnots(value), (int32_t)CMSEC_TO_CENTIKNOTS(value), 1);
+   }
+
+   // 1000km
+   EXPECT_EQ(328083989, osdCentimetersToCentifeet(100000000));
+   // 100ft
+   EXPECT_EQ(10000, osdCentimetersToCentifeet(3048));
+}
+
+// Times the velocity and time string formatting as done by
+// osdFormatVelocityStr() and osdFormatTime() before and after the switch
+// from float macros and tfp_sprintf() to integer math. Reports only, host
+// timings don't carry over to the FC.
+TEST(OSDTest, BenchmarkFormatting)
+{
+   const int iterations = 1000000;
+   char buf[16];
+   int sink = 0;
+
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; i++) {
+      const int32_t vel = i & 0x3FFF;
+      tfp_sprintf(buf, "%3d%c", (int)(CMSEC_TO_CENTIKPH(vel) / 100), SYM_KMH);
+      sink += buf[1];
+   }
+   const double velocitySprintfNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; i++) {
+      const int32_t vel = i & 0x3FFF;
+      char *ptr = buf + osdFormatInteger(buf, osdCmsToCentiKph(vel) / 100, 3, ' ');
+      ptr[0] = SYM_KMH;
+      ptr[1] = '\0';
+      sink += buf[1];
+   }
+   const double velocityIntegerNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; i++) {
+      const int value = i & 0x3FFF;
+      buf[0] = SYM_FLY_M;
+      tfp_sprintf(buf + 1, "%02d:%02d", value / 60, value % 60);
+      sink += buf[2];
+   }
+   const double timeSprintfNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+   start = std::chrono::steady_clock::now();
+   for (int i = 0; i < iterations; i++) {
+      const int value = i & 0x3FFF;
+      buf[0] = SYM_FLY_M;
+      char *ptr = buf + 1 + osdFormatInteger(buf + 1, value / 60, 2, '0');
+      *ptr++ = ':';
+      osdFormatInteger(ptr, value % 60, 2, '0');
+      sink += buf[2];
+   }
+   const double timeIntegerNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+   printf("velocity: tfp_sprintf %.1f ns, integer %.1f ns; time: tfp_sprintf %.1f ns, integer %.1f ns\n",
+      velocitySprintfNs, velocityIntegerNs, timeSprintfNs, timeIntegerNs);
+   RecordProperty("velocity_sprintf_ns", (int)(velocitySprintfNs * 10));
+   RecordProperty("velocity_integer_ns", (int)(velocityIntegerNs * 10));
+   RecordProperty("time_sprintf_ns", (int)(timeSprintfNs * 10));
+   RecordProperty("time_integer_ns", (int)(timeIntegerNs * 10));
+   EXPECT_NE(0, sink);
+}
+
+// STUBS
+
+extern "C" {
+
+// tfp_printf() output, unused here
+bool isSerialTransmitBufferEmpty(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return true;
+}
+
+void serialWrite(serialPort_t *instance, uint8_t ch)
+{
+    UNUSED(instance);
+    UNUSED(ch);
+}
+
+}
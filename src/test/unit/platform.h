@@ -84,3 +84,10 @@ extern SysTick_Type *SysTick;
 #define FAST_CODE 
 #define NOINLINE
 #define EXTENDED_FASTRAM
+
+#if defined(CONFIG_IN_RAM)
+#define EEPROM_SIZE     8192
+extern uint8_t eepromData[EEPROM_SIZE];
+#define __config_start (*eepromData)
+#define __config_end (*(eepromData + EEPROM_SIZE))
+#endif
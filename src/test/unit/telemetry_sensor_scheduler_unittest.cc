@@ -0,0 +1,133 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "telemetry/sensor_scheduler.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static int32_t testValues[4];
+static bool testAvailable[4];
+
+static bool testRead(const telemetrySensor_t *sensor, int32_t *value)
+{
+    if (!testAvailable[sensor->id]) {
+        return false;
+    }
+    *value = testValues[sensor->id];
+    return true;
+}
+
+static void testSetup(telemetrySensor_t *sensors, const uint8_t *priorities, const uint16_t *thresholds, unsigned count)
+{
+    telemetrySensorsReset(sensors, count);
+    for (unsigned ii = 0; ii < count; ii++) {
+        sensors[ii].id = ii;
+        sensors[ii].priority = priorities[ii];
+        sensors[ii].threshold = thresholds[ii];
+        testValues[ii] = 0;
+        testAvailable[ii] = true;
+    }
+}
+
+// Fills the given number of slots, counting how often each sensor was picked
+static void testRun(telemetrySensor_t *sensors, unsigned sensorCount, timeMs_t *now, int slots, int *picked)
+{
+    for (int ii = 0; ii < slots; ii++) {
+        int32_t value;
+        telemetrySensor_t *sensor = telemetrySensorNext(sensors, sensorCount, *now, testRead, &value);
+        ASSERT_TRUE(sensor != NULL);
+        picked[sensor->id]++;
+        telemetrySensorMarkSent(sensor, value, *now);
+        *now += 10;
+    }
+}
+
+TEST(TelemetrySensorSchedulerTest, SendsEverythingOnceFirst)
+{
+    const uint8_t priorities[] = { 1, 8, 1 };
+    const uint16_t thresholds[] = { 1, 1, 1 };
+    telemetrySensor_t sensors[3];
+    testSetup(sensors, priorities, thresholds, 3);
+
+    int picked[4] = { 0 };
+    timeMs_t now = 1000;
+    testRun(sensors, 3, &now, 3, picked);
+
+    EXPECT_EQ(1, picked[0]);
+    EXPECT_EQ(1, picked[1]);
+    EXPECT_EQ(1, picked[2]);
+}
+
+TEST(TelemetrySensorSchedulerTest, SkipsUnavailableAndDisabled)
+{
+    const uint8_t priorities[] = { 1, 0, 1 };
+    const uint16_t thresholds[] = { 1, 1, 1 };
+    telemetrySensor_t sensors[3];
+    testSetup(sensors, priorities, thresholds, 3);
+    testAvailable[2] = false;
+
+    int picked[4] = { 0 };
+    timeMs_t now = 1000;
+    testRun(sensors, 3, &now, 10, picked);
+
+    EXPECT_EQ(10, picked[0]);
+    EXPECT_EQ(0, picked[1]);
+    EXPECT_EQ(0, picked[2]);
+
+    testAvailable[0] = false;
+    int32_t value;
+    EXPECT_TRUE(telemetrySensorNext(sensors, 3, now, testRead, &value) == NULL);
+}
+
+TEST(TelemetrySensorSchedulerTest, PriorityAndChangesGetMoreSlots)
+{
+    const uint8_t priorities[] = { 1, 3, 1 };
+    const uint16_t thresholds[] = { 1, 1, 10 };
+    telemetrySensor_t sensors[3];
+    testSetup(sensors, priorities, thresholds, 3);
+
+    int picked[4] = { 0 };
+    timeMs_t now = 1000;
+    testRun(sensors, 3, &now, 300, picked);
+
+    // Nothing changes, slots follow priority
+    EXPECT_GE(picked[1], 2 * picked[0]);
+    EXPECT_NEAR(picked[0], picked[2], 2);
+
+    // Sensor 2 moves by more than its threshold every slot
+    int changing[4] = { 0 };
+    for (int ii = 0; ii < 300; ii++) {
+        testValues[2] += 20;
+        testRun(sensors, 3, &now, 1, changing);
+    }
+    EXPECT_GT(changing[2], changing[1]);
+    EXPECT_GT(changing[0], 0);
+
+    // Changes below the threshold don't count
+    int small[4] = { 0 };
+    for (int ii = 0; ii < 300; ii++) {
+        testValues[2] += (ii & 1) ? 5 : -5;
+        testRun(sensors, 3, &now, 1, small);
+    }
+    EXPECT_NEAR(small[0], small[2], 2);
+}
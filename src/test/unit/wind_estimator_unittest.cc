@@ -0,0 +1,99 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "common/maths.h"
+
+    #include "fc/runtime_config.h"
+
+    #include "flight/imu.h"
+    #include "flight/wind_estimator.h"
+
+    #include "io/gps.h"
+
+    #include "navigation/navigation_pos_estimator_private.h"
+
+    static timeUs_t currentTimeUs;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define GPS_RATE_HZ     10
+#define AIRSPEED        1500.0f     // cm/s
+#define TURN_PERIOD_S   20          // a full circle in 20 s
+
+// Circle at a constant airspeed for the given time, GPS reports airspeed plus wind
+static void fly(float windX, float windY, int seconds)
+{
+    for (int i = 0; i < seconds * GPS_RATE_HZ; i++) {
+        currentTimeUs += USECS_PER_SEC / GPS_RATE_HZ;
+        const float heading = 2 * M_PIf * US2S(currentTimeUs) / TURN_PERIOD_S;
+
+        HeadVecEFFiltered.x = cosf(heading);
+        HeadVecEFFiltered.y = -sinf(heading);
+        HeadVecEFFiltered.z = 0;
+
+        posEstimator.gps.vel.x = windX + AIRSPEED * cosf(heading);
+        posEstimator.gps.vel.y = windY + AIRSPEED * sinf(heading);
+        posEstimator.gps.vel.z = 0;
+
+        updateWindEstimator(currentTimeUs);
+    }
+}
+
+TEST(WindEstimatorTest, FollowsWindStep)
+{
+    ENABLE_STATE(FIXED_WING_LEGACY);
+    gpsSol.flags.validVelNE = true;
+    gpsSol.flags.validVelD = true;
+
+    fly(500, 0, 60);
+    ASSERT_TRUE(isEstimatedWindSpeedValid());
+    EXPECT_NEAR(getEstimatedWindSpeed(X), 500, 50);
+    EXPECT_NEAR(getEstimatedWindSpeed(Y), 0, 50);
+
+    // The wind veers and picks up at once, way outside the gate of the converged fit
+    fly(-300, 600, 10);
+    ASSERT_TRUE(isEstimatedWindSpeedValid());
+    EXPECT_NEAR(getEstimatedWindSpeed(X), -300, 50);
+    EXPECT_NEAR(getEstimatedWindSpeed(Y), 600, 50);
+}
+
+// STUBS
+
+extern "C" {
+
+uint32_t stateFlags;
+int32_t debug[DEBUG32_VALUE_COUNT];
+uint8_t debugMode;
+
+gpsSolutionData_t gpsSol;
+navigationPosEstimator_t posEstimator;
+fpVector3_t HeadVecEFFiltered;
+
+bool isGPSHeadingValid(void) { return true; }
+timeUs_t micros(void) { return currentTimeUs; }
+
+}